@@ -32,6 +32,11 @@ void main() {
 
         if(gantt) displayGantt(gantt);
         displayProcesses(process, n);
+
+        /*
+            *** To export the schedule as a Chrome trace (open in ui.perfetto.dev) ***
+            exportChromeTrace("trace.json", gantt, process, n);
+        */
         
         destroyGantt(gantt);
         destroyProcesses(process);
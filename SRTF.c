@@ -31,6 +31,11 @@ void main() {
 
         if(gantt) displayGantt(gantt);
         displayProcesses(processes, n);
+
+        /*
+            *** To export the schedule as a Chrome trace (open in ui.perfetto.dev) ***
+            exportChromeTrace("trace.json", gantt, processes, n);
+        */
         
         destroyGantt(gantt);
         destroyProcesses(processes);
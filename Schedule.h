@@ -3,9 +3,44 @@
 #ifndef SCHEDULER_H
 #define SCHEDULER_H
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE                                 // pthread_setaffinity_np, CPU_SET (only if this header comes first)
+#endif
+
 #include<stdio.h>
 #include<stdlib.h>
 #include<string.h>
+#include<limits.h>
+#include<pthread.h>
+#include<sched.h>
+#include<time.h>
+#include<unistd.h>
+
+/*
+    Worker threads are pinned to CPUs only if sched.h declares the affinity API, which glibc does when
+    _GNU_SOURCE is defined before the first system header (compile with -D_GNU_SOURCE if a system header
+    is included before this one). Otherwise the pool runs unpinned on the online CPUs.
+*/
+#ifdef CPU_SETSIZE
+#define SCHED_MAX_CPUS CPU_SETSIZE
+#else
+#define SCHED_MAX_CPUS 1024
+#endif
+
+/*
+    Type of every time value (arrival, burst, wait, turnaround, GANTT chart times).
+    32-bit by default, compile with -DSCHED_TIME_64 for 64-bit times (e.g. nanosecond traces).
+    TIME_FMT is the matching printf / scanf conversion.
+*/
+#ifdef SCHED_TIME_64
+typedef long long SCHED_TIME;
+#define TIME_FMT "%lld"
+#define TIME_MAX LLONG_MAX
+#else
+typedef int SCHED_TIME;
+#define TIME_FMT "%d"
+#define TIME_MAX INT_MAX
+#endif
 
 typedef struct process
 {
@@ -14,20 +49,83 @@ typedef struct process
             Structure to represent a process in scheduling algorithms.
 
         VARIABLES:
-            - pid (int):                Unique identifier for the process.
-            - arrive_time (int):        Time at which the process arrives in the system.
-            - burst_time (int):         CPU burst time required by the process.
-            - turnaround_time (int):    Total time from arrival to completion (finish - arrival).
-            - wait_time (int):          Total time the process waits in the ready queue.
-            - priority (int):           Priority of the process (lower value = higher priority).
-            - initial_burst (int):      Backup copy of the original burst time for calculations.
+            - pid (int):                    Unique identifier for the process.
+            - arrive_time (SCHED_TIME):     Time at which the process arrives in the system.
+            - burst_time (SCHED_TIME):      CPU burst time required by the process.
+            - turnaround_time (SCHED_TIME): Total time from arrival to completion (finish - arrival).
+            - wait_time (SCHED_TIME):       Total time the process waits in the ready queue.
+            - priority (int):               Priority of the process (lower value = higher priority).
+            - initial_burst (SCHED_TIME):   Backup copy of the original burst time for calculations.
     */
 
-    int pid, arrive_time, burst_time;
-    int turnaround_time, wait_time;
-    int priority, initial_burst;
+    int pid;
+    SCHED_TIME arrive_time, burst_time;
+    SCHED_TIME turnaround_time, wait_time;
+    int priority;
+    SCHED_TIME initial_burst;
 }PROCESS;
 
+typedef struct processhot
+{
+    /*
+        INTRODUCTION:
+            Structure to represent the fields of a process read by the selection loops of the algorithms.
+
+        VARIABLES:
+            - arrive_time (SCHED_TIME): Time at which the process arrives in the system.
+            - burst_time (SCHED_TIME):  CPU burst time (remaining burst time for preemptive algorithms).
+            - priority (int):           Priority of the process (lower value = higher priority).
+    */
+
+    SCHED_TIME arrive_time, burst_time;
+    int priority;
+}PROCESS_HOT;
+
+typedef struct processout
+{
+    /*
+        INTRODUCTION:
+            Structure to represent the results of a process.
+
+        VARIABLES:
+            - turnaround_time (SCHED_TIME): Total time from arrival to completion (finish - arrival).
+            - wait_time (SCHED_TIME):       Total time the process waits in the ready queue.
+    */
+
+    SCHED_TIME turnaround_time, wait_time;
+}PROCESS_OUT;
+
+typedef struct workload
+{
+    /*
+        INTRODUCTION:
+            Structure to represent processes as a struct of arrays, used by the algorithms internally.
+            Hot fields are packed together (12 bytes per process instead of 28 with 32-bit times), results and
+            rarely used fields live in separate arrays, and the algorithms move 4-byte indices
+            in order instead of whole records.
+
+        VARIABLES:
+            - n (int):                     Number of processes.
+            - hot (PROCESS_HOT*):          Fields read while scheduling.
+            - out (PROCESS_OUT*):          Wait and turnaround times.
+            - pid (int*):                  Process IDs.
+            - initial_burst (SCHED_TIME*): Original burst times.
+            - order (int*):                Indices of the processes in sorted / dispatch order.
+    */
+
+    int n;
+    PROCESS_HOT *hot;
+    PROCESS_OUT *out;
+    int *pid;
+    SCHED_TIME *initial_burst;
+    int *order;
+}WORKLOAD;
+
+typedef enum
+{
+    SORT_NONE, SORT_BURST, SORT_BURST_DESC, SORT_PRIORITY
+}SORT_KEY;
+
 typedef struct gantt
 {
     /*
@@ -35,16 +133,684 @@ typedef struct gantt
             Structure to represent a single entry in a GANTT chart for process scheduling.
 
         VARIABLES:
-            - pid (int):            Process ID executed during this time slot (-1 for IDLE).
-            - start_time (int):     Starting time of this GANTT chart entry.
-            - finish_time (int):    Ending time of this GANTT chart entry.
-            - next (struct gantt*): Pointer to the next GANTT chart entry (linked list structure).
+            - pid (int):                Process ID executed during this time slot (-1 for IDLE, -2 for context switch).
+            - start_time (SCHED_TIME):  Starting time of this GANTT chart entry.
+            - finish_time (SCHED_TIME): Ending time of this GANTT chart entry.
+            - next (struct gantt*):     Pointer to the next GANTT chart entry (linked list structure).
     */
 
-    int pid, start_time, finish_time;
+    int pid;
+    SCHED_TIME start_time, finish_time;
     struct gantt *next;
 }GANTT;
 
+typedef struct ganttbuffer
+{
+    /*
+        INTRODUCTION:
+            Structure to represent a reusable block of GANTT chart entries for the non-preemptive
+            algorithms, whose charts never have more than 2n entries.
+
+        VARIABLES:
+            - data (GANTT*):            Entries, linked in chart order after a run.
+            - capacity (int):           Allocated entries.
+            - used (int):               Entries of the last run.
+    */
+
+    GANTT *data;
+    int capacity, used;
+}GANTT_BUFFER;
+
+#define RLE_CHECKPOINT_EVERY 256            // segments between two random access points of a GANTT_RLE
+
+typedef struct rlecheckpoint
+{
+    /*
+        INTRODUCTION:
+            Structure to represent a random access point into a compressed GANTT chart.
+
+        VARIABLES:
+            - offset (size_t):          Byte offset of the segment in the encoded data.
+            - index (long long):        Index of the segment.
+            - last (SCHED_TIME):        Finish time of the previous segment (0 for the first one).
+    */
+
+    size_t offset;
+    long long index;
+    SCHED_TIME last;
+}RLE_CHECKPOINT;
+
+typedef struct ganttrle
+{
+    /*
+        INTRODUCTION:
+            Structure to represent a compressed (run-length encoded) GANTT chart.
+
+        VARIABLES:
+            - data (unsigned char*):        Encoded segments, each one is three varints:
+                                            pid+2, start time minus the previous finish time (zigzag) and duration.
+            - size, capacity (size_t):      Bytes used and allocated.
+            - count (long long):            Number of segments.
+            - last (SCHED_TIME):            Finish time of the last segment.
+            - check (RLE_CHECKPOINT*):      One checkpoint every RLE_CHECKPOINT_EVERY segments.
+            - n_check, check_capacity (long long): Checkpoints used and allocated.
+    */
+
+    unsigned char *data;
+    size_t size, capacity;
+    long long count;
+    SCHED_TIME last;
+    RLE_CHECKPOINT *check;
+    long long n_check, check_capacity;
+}GANTT_RLE;
+
+typedef struct ganttcursor
+{
+    /*
+        INTRODUCTION:
+            Structure to represent a decoding position in a GANTT_RLE.
+
+        VARIABLES:
+            - rle (GANTT_RLE*):         Chart being decoded.
+            - offset (size_t):          Byte offset of the next segment.
+            - index (long long):        Index of the next segment.
+            - last (SCHED_TIME):        Finish time of the previous segment.
+    */
+
+    GANTT_RLE *rle;
+    size_t offset;
+    long long index;
+    SCHED_TIME last;
+}GANTT_CURSOR;
+
+typedef struct ganttsink
+{
+    /*
+        INTRODUCTION:
+            Structure to represent the output of a scheduler: a GANTT linked list, a GANTT_RLE,
+            or only the totals below. Entries are held back by one so they can still be merged.
+
+        VARIABLES:
+            - ghead, gcurr (GANTT*):    Linked list being built (if rle is NULL and discard is not set).
+            - rle (GANTT_RLE*):         Compressed chart being built, NULL for a linked list.
+            - buffer (GANTT_BUFFER*):   Entries of the linked list are taken from it if set, else from ganttAlloc().
+            - merge (int):              Non-zero to merge consecutive entries of the same process
+                                        (IDLE entries are always merged).
+            - discard (int):            Non-zero to only count the entries, nothing is allocated.
+            - pending (GANTT):          Entry not written yet, valid if has_pending is set.
+            - has_pending (int):        Non-zero if pending holds an entry.
+            - dispatches, idle (long long): Process and IDLE entries written.
+            - busy (SCHED_TIME):        Total length of the process entries.
+            - last (SCHED_TIME):        Finish time of the last entry written.
+    */
+
+    GANTT *ghead, *gcurr;
+    GANTT_RLE *rle;
+    GANTT_BUFFER *buffer;
+    int merge, discard;
+    GANTT pending;
+    int has_pending;
+    long long dispatches, idle;
+    SCHED_TIME busy, last;
+}GANTT_SINK;
+
+typedef struct schedsummary
+{
+    /*
+        INTRODUCTION:
+            Structure to represent the result of one algorithm on one workload, without its GANTT chart.
+
+        VARIABLES:
+            - avg_wait (double):        Average waiting time.
+            - avg_tat (double):         Average turnaround time.
+            - makespan (SCHED_TIME):    Finish time of the last GANTT chart entry.
+            - busy (SCHED_TIME):        Time the CPU was not IDLE.
+            - entries (long long):      Number of GANTT chart entries (dispatches and IDLE gaps).
+    */
+
+    double avg_wait, avg_tat;
+    SCHED_TIME makespan, busy;
+    long long entries;
+}SCHED_SUMMARY;
+
+typedef struct ganttindex
+{
+    /*
+        INTRODUCTION:
+            Structure to represent a GANTT chart indexed for time-window queries.
+
+        VARIABLES:
+            - count (long long):        Number of entries.
+            - start, finish (SCHED_TIME*): Time slots of the entries, in time order.
+            - pid (int*):               Process IDs of the entries (-1 for IDLE, -2 for context switch).
+            - busy (SCHED_TIME*):       busy[i] is the time processes ran in entries 0 ... i-1 (count+1 values).
+    */
+
+    long long count;
+    SCHED_TIME *start, *finish;
+    int *pid;
+    SCHED_TIME *busy;
+}GANTT_INDEX;
+
+typedef struct switchcost
+{
+    /*
+        INTRODUCTION:
+            Structure to represent the cost of dispatching a process on the CPU.
+
+        VARIABLES:
+            - fixed (SCHED_TIME):       Fixed cost of every context switch (saving/restoring state, dispatcher).
+            - warmup (SCHED_TIME):      Extra cost to refill a completely cold cache.
+            - cold_after (SCHED_TIME):  Time away from the CPU after which the cache of a process is completely cold.
+                                    The warm-up penalty grows linearly up to that point (<= 0: always cold).
+    */
+
+    SCHED_TIME fixed, warmup, cold_after;
+}SWITCH_COST;
+
+typedef struct pstate
+{
+    /*
+        INTRODUCTION:
+            Structure to represent one performance state (voltage / frequency pair) of the CPU.
+
+        VARIABLES:
+            - speed (double):           Work done per time unit relative to the speed the GANTT chart assumes (1).
+            - power (double):           Power drawn while running in this state (watts).
+    */
+
+    double speed, power;
+}P_STATE;
+
+typedef struct energymodel
+{
+    /*
+        INTRODUCTION:
+            Structure to represent the power model of the CPU.
+
+        VARIABLES:
+            - state (P_STATE*):         Performance states, in any order.
+            - n_states (int):           Number of performance states.
+            - idle_power (double):      Power drawn while IDLE (watts).
+            - seconds (double):         Length of one time unit in seconds.
+    */
+
+    P_STATE *state;
+    int n_states;
+    double idle_power, seconds;
+}ENERGY_MODEL;
+
+typedef enum
+{
+    DVFS_RACE_TO_IDLE, DVFS_SLOW_AND_STEADY,
+    DVFS_COUNT
+}DVFS_POLICY;
+
+typedef struct energyreport
+{
+    /*
+        INTRODUCTION:
+            Structure to represent the energy and timing of a schedule under a DVFS policy.
+
+        VARIABLES:
+            - busy_joules (double):     Energy used running processes (and context switches).
+            - idle_joules (double):     Energy used while IDLE, up to the later of both makespans.
+            - joules (double):          Total energy.
+            - busy_time (double):       Time spent running, in time units.
+            - makespan (double):        Time at which the last entry finishes, in time units.
+            - avg_turnaround (double):  Average turnaround time of the processes in the chart, in time units.
+            - edp (double):             Energy-delay product, joules * makespan in seconds.
+    */
+
+    double busy_joules, idle_joules, joules;
+    double busy_time, makespan, avg_turnaround;
+    double edp;
+}ENERGY_REPORT;
+
+typedef struct ioprocess
+{
+    /*
+        INTRODUCTION:
+            Structure to represent a process that alternates between CPU and I/O bursts.
+
+        VARIABLES:
+            - pid (int):                    Unique identifier for the process.
+            - arrive_time (SCHED_TIME):     Time at which the process arrives in the system.
+            - priority (int):               Priority of the process (lower value = higher priority).
+            - n_bursts (int):               Number of bursts (odd: CPU, I/O, CPU, ..., CPU).
+            - bursts (SCHED_TIME*):         Lengths of the bursts, even indices are CPU bursts, odd indices are I/O bursts.
+            - current (int):                Index of the burst being executed / waited for.
+            - remaining (SCHED_TIME):       Remaining time of the current burst.
+            - ready_since (SCHED_TIME):     Time at which the process last entered the ready queue.
+            - turnaround_time (SCHED_TIME): Total time from arrival to completion (finish - arrival).
+            - wait_time (SCHED_TIME):       Total time the process waits in the ready queue.
+            - cpu_time (SCHED_TIME):        Sum of the CPU bursts.
+            - io_time (SCHED_TIME):         Sum of the I/O bursts.
+    */
+
+    int pid;
+    SCHED_TIME arrive_time;
+    int priority;
+    int n_bursts;
+    SCHED_TIME *bursts;
+    int current;
+    SCHED_TIME remaining, ready_since;
+    SCHED_TIME turnaround_time, wait_time;
+    SCHED_TIME cpu_time, io_time;
+}IO_PROCESS;
+
+typedef enum
+{
+    POLICY_FCFS, POLICY_SJF, POLICY_HRRN, POLICY_PRIORITY, POLICY_LJF,
+    POLICY_SRTF, POLICY_PRIORITY_PREEMPTIVE, POLICY_LRTF, POLICY_ROUND_ROBIN,
+    POLICY_COUNT
+}SCHED_POLICY;
+
+typedef struct heap
+{
+    /*
+        INTRODUCTION:
+            Structure to represent a binary min-heap of process indices.
+
+        VARIABLES:
+            - data (int*):          Array of indices, data[0] is the smallest.
+            - size (int):           Number of indices in the heap.
+            - capacity (int):       Allocated length of data.
+            - less (function):      Returns non-zero if index a must come before index b.
+            - ctx (void*):          Context passed to less (e.g. the process array).
+    */
+
+    int *data, size, capacity;
+    int (*less)(void *, int, int);
+    void *ctx;
+}HEAP;
+
+#define RUNQ_MAX_LEVELS 4096                // widest priority range of the bitmap run queue (64 words of 64 bits)
+
+typedef struct runqueue
+{
+    /*
+        INTRODUCTION:
+            Structure to represent the ready processes of the Priority algorithms: one FIFO list per
+            priority and a bitmap of the non-empty lists, or a heap if the priority range is too wide.
+
+        VARIABLES:
+            - hot (PROCESS_HOT*):       Processes, the queue holds their indices.
+            - base (int):               Priority of list 0.
+            - levels (int):             Number of lists (priority range), 0 if the heap is used.
+            - summary (unsigned long long): Bit k is set if bitmap[k] is not zero.
+            - bitmap (unsigned long long*): Bit p is set if list p is not empty.
+            - head, tail (int*):        First and last index of every list, -1 if empty.
+            - next (int*):              Next index in the same list, per process.
+            - heap (HEAP):              Ready processes if levels is 0.
+            - size (int):               Number of queued processes.
+    */
+
+    PROCESS_HOT *hot;
+    int base, levels;
+    unsigned long long summary, *bitmap;
+    int *head, *tail, *next;
+    HEAP heap;
+    int size;
+}RUNQUEUE;
+
+#define WHEEL_BITS 6                        // 64 slots per level of the timing wheel, one bit each in a word
+#define WHEEL_LEVELS ((int)((sizeof(SCHED_TIME)*8 + WHEEL_BITS-1) / WHEEL_BITS))
+#define EVENTQ_WHEEL_MIN 4096               // EVENTQ_AUTO keeps the heap while fewer events are queued
+#define EVENTQ_WHEEL_SPREAD 64              // and switches to the wheel if they span at most this many time units each
+
+typedef enum
+{
+    EVENTQ_AUTO, EVENTQ_HEAP, EVENTQ_WHEEL
+}EVENTQ_KIND;
+
+typedef struct event_queue
+{
+    /*
+        INTRODUCTION:
+            Structure to represent future events (process indices with a time, e.g. arrivals), taken out in
+            order of time, then of less: a binary heap, or a hierarchical timing wheel for dense integer times.
+
+        VARIABLES:
+            - kind (EVENTQ_KIND):       Queue in use (EVENTQ_AUTO is a heap that may switch to the wheel).
+            - size (int):               Number of queued events.
+            - time (SCHED_TIME*):       Time of the event of every index.
+            - next (int*):              Next index in the same wheel slot.
+            - capacity (int):           Allocated length of time and next.
+            - less (function):          Order of events at the same time.
+            - ctx (void*):              Context passed to less.
+            - due (HEAP):               Every event (heap), the events at time now (wheel).
+            - now (SCHED_TIME):         Time of the last event taken out, no queued event is earlier.
+            - next_time (SCHED_TIME):   Earliest time in the wheel slots, -1 if not known.
+            - check_at (int):           Size at which EVENTQ_AUTO looks at the spread of the times again.
+            - occupied (unsigned long long[]): Bit k of level l is set if slot k of level l is not empty.
+            - slot (int[][]):           First index of every slot, -1 if empty. Level l holds the times that
+                                        differ from now in bits 6l to 6l+5 (and not above), in the slot of those bits.
+    */
+
+    EVENTQ_KIND kind;
+    int size;
+    SCHED_TIME *time;
+    int *next, capacity;
+    int (*less)(void *, int, int);
+    void *ctx;
+    HEAP due;
+    SCHED_TIME now, next_time;
+    int check_at;
+    unsigned long long occupied[WHEEL_LEVELS];
+    int slot[WHEEL_LEVELS][1 << WHEEL_BITS];
+}EVENT_QUEUE;
+
+#define CGROUP_DEFAULT_SHARES 1024          // weight of a group with the default share of the CPU
+
+typedef struct cgroup
+{
+    /*
+        INTRODUCTION:
+            Structure to represent a control group: processes (or subgroups) sharing a weight among their
+            siblings and, optionally, a CPU bandwidth quota per period.
+
+        VARIABLES:
+            - parent (int):                 Index of the parent group, -1 for a top level group.
+            - shares (int):                 Weight among the siblings (CGROUP_DEFAULT_SHARES = default).
+            - quota (SCHED_TIME):           CPU time the group and its subgroups may use per period (0 = no limit).
+            - period (SCHED_TIME):          Length of a quota period, periods start at multiples of it.
+            - children (int):               Number of subgroups (processes may only belong to groups without any).
+            - usage (SCHED_TIME):           CPU time used by the group and its subgroups.
+            - throttled_time (SCHED_TIME):  Time spent throttled (quota used up before the end of the period).
+            - nr_throttled (int):           Number of periods in which the group was throttled.
+            - completed (int):              Number of completed processes of the group and its subgroups.
+            - wait_time (SCHED_TIME):       Total wait time of those processes.
+            - vruntime (double):            CPU time used, scaled by CGROUP_DEFAULT_SHARES / shares.
+            - min_vruntime (double):        Largest vruntime of a subgroup picked so far (groups waking up start there).
+            - runtime_left (SCHED_TIME):    Quota left in the current period.
+            - period_index (SCHED_TIME):    Period of runtime_left (time / period).
+            - throttle_start (SCHED_TIME):  Time at which the group was last throttled.
+            - throttled (int):              Non-zero while the group is throttled.
+            - queued (int):                 Non-zero while the group is in the run queue of its parent.
+            - head, tail (int):             First and last runnable process of the group, -1 if none.
+            - heap (HEAP):                  Runnable subgroups that are not throttled, ordered on vruntime.
+    */
+
+    int parent, shares;
+    SCHED_TIME quota, period;
+    int children;
+    SCHED_TIME usage, throttled_time;
+    int nr_throttled, completed;
+    SCHED_TIME wait_time;
+    double vruntime, min_vruntime;
+    SCHED_TIME runtime_left, period_index, throttle_start;
+    int throttled, queued;
+    int head, tail;
+    HEAP heap;
+}CGROUP;
+
+typedef struct cpu_core
+{
+    /*
+        INTRODUCTION:
+            Structure to represent one core of a heterogeneous multiprocessor.
+
+        VARIABLES:
+            - speed (double):           Work done per time unit (1 = reference core), a burst of burst_time
+                                        takes burst_time / speed, rounded up, on this core.
+            - power (double):           Power drawn while busy (any unit), used by energy-aware placement.
+            - processes (int):          Number of processes placed on the core.
+            - work (SCHED_TIME):        Sum of their burst times (reference core time).
+            - busy (SCHED_TIME):        Time the core spent running them.
+            - finish (SCHED_TIME):      Time at which the core ran its last process.
+    */
+
+    double speed, power;
+    int processes;
+    SCHED_TIME work, busy, finish;
+}CPU_CORE;
+
+typedef enum
+{
+    PLACE_FASTEST_FREE, PLACE_ENERGY_AWARE,
+    PLACE_COUNT
+}PLACEMENT;
+
+typedef struct aging
+{
+    /*
+        INTRODUCTION:
+            Structure to represent the ready queue state of priority scheduling with aging.
+
+        VARIABLES:
+            - hot (PROCESS_HOT*):           Hot fields of the workload.
+            - ready_since (SCHED_TIME*):    Time at which each process last entered the ready queue.
+            - interval (SCHED_TIME):        Waiting time after which priority improves by one level (0 = no aging).
+    */
+
+    PROCESS_HOT *hot;
+    SCHED_TIME *ready_since, interval;
+}AGING;
+
+#define CHECKPOINT_MAGIC "SCHEDCK1"         // first 8 bytes of a checkpoint of the online scheduler (version 1)
+
+typedef struct scheduler
+{
+    /*
+        INTRODUCTION:
+            Structure to represent an online (incremental) scheduler.
+
+        VARIABLES:
+            - policy (SCHED_POLICY):    Scheduling algorithm.
+            - time_slice (SCHED_TIME):  Time quantum (only used by Round Robin).
+            - curr_time (SCHED_TIME):   Time up to which the schedule has been built.
+            - process (PROCESS*):       Submitted processes, in order of submission (burst_time is the remaining time).
+            - n (int):                  Number of submitted processes.
+            - capacity (int):           Allocated length of process.
+            - completed (int):          Number of completed processes.
+            - pending (EVENT_QUEUE):    Submitted processes that have not arrived yet, keyed on arrival time.
+            - ready (HEAP):             Ready processes ordered by the algorithm.
+            - queue (int*):             Ready processes in arrival order (Round Robin, HRRN).
+            - q_front, q_size (int):    Front and size of the circular queue.
+            - running (int):            Index of the process on the CPU (-1 if none).
+            - run_start (SCHED_TIME):   Start time of the current GANTT entry of the running process.
+            - slice_end (SCHED_TIME):   Time at which the time slice of the running process expires.
+            - idle_since (SCHED_TIME):  Time since which the CPU is IDLE (-1 if busy).
+            - ghead, gcurr (GANTT*):    Finished GANTT entries that have not been polled yet.
+            - polled (long long):       Number of GANTT entries polled so far.
+            - output_offset (long long): Position the caller reached in its own output (e.g. bytes written),
+                                        kept in checkpoints so a resumed run knows where to continue.
+            - checkpoint (char*):       Path of the checkpoint file (NULL = no checkpoints).
+            - checkpoint_interval (SCHED_TIME): Time between two checkpoints.
+            - next_checkpoint (SCHED_TIME): Time of the next checkpoint.
+    */
+
+    SCHED_POLICY policy;
+    SCHED_TIME time_slice, curr_time;
+    PROCESS *process;
+    int n, capacity, completed;
+    EVENT_QUEUE pending;
+    HEAP ready;
+    int *queue, q_front, q_size;
+    int running;
+    SCHED_TIME run_start, slice_end, idle_since;
+    GANTT *ghead, *gcurr;
+    long long polled, output_offset;
+    char *checkpoint;
+    SCHED_TIME checkpoint_interval, next_checkpoint;
+}SCHEDULER;
+
+typedef struct arena
+{
+    /*
+        INTRODUCTION:
+            Structure to represent a scratch memory arena (bump allocator), used to run many small
+            workloads without calling malloc / free for every GANTT entry and work array.
+
+        VARIABLES:
+            - base (char*):     Current block, its first bytes link to the previous (spilled) block.
+            - size (size_t):    Size of the current block.
+            - used (size_t):    Bytes used in the current block.
+            - total (size_t):   Bytes handed out since the last reset.
+            - spill (char*):    Blocks filled before the current one, freed on reset.
+    */
+
+    char *base;
+    size_t size, used, total;
+    char *spill;
+}ARENA;
+
+/*
+    Arena used by the scheduling algorithms of the calling thread (NULL = malloc / free).
+    Memory of GANTT charts built while an arena is bound belongs to the arena: it is released by
+    arenaReset / arenaDestroy, destroyGantt is then a no-op.
+*/
+static __thread ARENA *schedArena = NULL;
+
+typedef struct job
+{
+    /*
+        INTRODUCTION:
+            Structure to represent one scheduling run submitted to a thread pool.
+
+        VARIABLES:
+            - policy (SCHED_POLICY):    Scheduling algorithm.
+            - process (PROCESS*):       Input processes (not modified, may be shared by many jobs).
+            - n (int):                  Number of processes.
+            - time_slice (SCHED_TIME):  Time quantum (only used by Round Robin).
+            - finish (function):        Called on the worker with the results (NULL to keep them).
+            - ctx (void*):              Caller data for finish.
+            - summary (SCHED_SUMMARY*): If set, only statistics are computed, into *summary: no GANTT chart
+                                        is built and result is only valid in finish.
+            - result (PROCESS*):        Copy of process with the wait and turnaround times filled.
+            - gantt (GANTT*):           GANTT chart of the run.
+    */
+
+    SCHED_POLICY policy;
+    PROCESS *process;
+    int n;
+    SCHED_TIME time_slice;
+    void (*finish)(struct job *);
+    void *ctx;
+    SCHED_SUMMARY *summary;
+    PROCESS *result;
+    GANTT *gantt;
+}JOB;
+
+typedef struct worker
+{
+    /*
+        INTRODUCTION:
+            Structure to represent a thread of a work-stealing thread pool.
+
+        VARIABLES:
+            - pool (struct pool*):      Pool of the worker.
+            - thread (pthread_t):       Thread running the worker.
+            - id (int):                 Index of the worker in the pool.
+            - cpu, node (int):          CPU the worker is pinned to (-1 if not pinned) and its NUMA node.
+            - jobs (JOB**):             Deque of jobs (circular), the owner works at the bottom, thieves take the top.
+            - top, size (int):          First job and number of jobs in the deque.
+            - capacity (int):           Allocated length of jobs.
+            - lock (pthread_mutex_t):   Protects the deque.
+            - arena (ARENA):            Memory of the results of the jobs run by the worker.
+            - held (int):               Number of results kept in arena.
+    */
+
+    struct pool *pool;
+    pthread_t thread;
+    int id, cpu, node;
+    JOB **jobs;
+    int top, size, capacity;
+    pthread_mutex_t lock;
+    ARENA arena;
+    int held;
+}WORKER;
+
+typedef struct pool
+{
+    /*
+        INTRODUCTION:
+            Structure to represent a work-stealing thread pool that runs JOBs.
+
+        VARIABLES:
+            - worker (WORKER*):         Workers.
+            - n_workers (int):          Number of workers.
+            - next (int):               Worker that receives the next job submitted from outside the pool.
+            - queued (int):             Jobs waiting in the deques.
+            - outstanding (int):        Jobs submitted and not finished yet.
+            - sleeping (int):           Workers waiting for jobs.
+            - shutdown (int):           Set when the pool is destroyed.
+            - lock (pthread_mutex_t):   Protects sleeping and the two condition variables.
+            - work (pthread_cond_t):    Signalled when jobs are queued.
+            - done (pthread_cond_t):    Signalled when outstanding drops to 0.
+    */
+
+    WORKER *worker;
+    int n_workers, next;
+    int queued, outstanding, sleeping, shutdown;
+    pthread_mutex_t lock;
+    pthread_cond_t work, done;
+}POOL;
+
+static __thread WORKER *poolSelf = NULL;            // worker running on the calling thread
+
+typedef struct schedcounters
+{
+    /*
+        INTRODUCTION:
+            Structure to represent the instrumentation counters of the scheduling algorithms
+            (only updated when compiled with -DSCHED_STATS).
+
+        VARIABLES:
+            - runs (long long):             Number of getGantt* calls.
+            - dispatches (long long):       Process entries in the GANTT charts (a process put on the CPU).
+            - preemptions (long long):      Dispatches that ended before the process completed.
+            - comparisons (long long):      Candidates examined by the selection loops.
+            - gantt_allocated (long long):  GANTT entries allocated.
+            - gantt_merged (long long):     GANTT entries that extended the previous entry instead of being added.
+            - idle_segments (long long):    IDLE entries in the GANTT charts.
+            - sort_ms (double):             Time spent copying and sorting the workloads.
+            - simulate_ms (double):         Time spent building the schedules.
+    */
+
+    long long runs, dispatches, preemptions, comparisons;
+    long long gantt_allocated, gantt_merged, idle_segments;
+    double sort_ms, simulate_ms;
+}SCHED_COUNTERS;
+
+#ifdef SCHED_STATS
+static __thread SCHED_COUNTERS schedCounters;       // counters of the calling thread
+SCHED_COUNTERS schedCountersTotal;                  // counters flushed by all threads
+pthread_mutex_t schedCountersLock = PTHREAD_MUTEX_INITIALIZER;
+#define STATS_ADD(field, value) (schedCounters.field += (value))
+#define STATS_CLOCK(t) struct timespec t; clock_gettime(CLOCK_MONOTONIC, &t)
+#define STATS_RUN(ghead, n, start, sorted) statsRecordRun(ghead, NULL, n, &start, &sorted)
+#define STATS_SINK(sink, n, start, sorted) statsRecordRun(NULL, sink, n, &start, &sorted)
+#else
+#define STATS_ADD(field, value)
+#define STATS_CLOCK(t)
+#define STATS_RUN(ghead, n, start, sorted)
+#define STATS_SINK(sink, n, start, sorted)
+#endif
+
+const char *policyNames[POLICY_COUNT] = {
+    "FCFS", "SJF", "HRRN", "Priority", "LJF",
+    "SRTF", "Priority (preemptive)", "LRTF", "Round Robin"
+};
+
+const char *placementNames[PLACE_COUNT] = {
+    "Fastest free core first", "Energy aware"
+};
+
+const char *dvfsNames[DVFS_COUNT] = {
+    "Race to idle", "Slow and steady"
+};
+
+const SORT_KEY policySortKeys[POLICY_COUNT] = {     // order among equal arrival times
+    SORT_NONE, SORT_BURST, SORT_BURST, SORT_PRIORITY, SORT_BURST_DESC,
+    SORT_BURST, SORT_PRIORITY, SORT_BURST_DESC, SORT_NONE
+};
+
+const int policyMerges[POLICY_COUNT] = {            // consecutive entries of the same process are merged
+    0, 0, 0, 0, 0, 1, 1, 1, 0
+};
+
 // PROCESS struct related functions
 PROCESS* getProcesses(int);
 PROCESS* getProcessesPriority(int);
@@ -52,6 +818,35 @@ int getProcessesFile(char *, PROCESS **);
 int getProcessesFilePriority(char *, PROCESS **);
 void displayProcesses(PROCESS *, int);
 void destroyProcesses(PROCESS *);
+int getBatchFile(char *, PROCESS **, int **);
+
+// Scratch memory arena
+void arenaInit(ARENA *, size_t);
+void* arenaAlloc(ARENA *, size_t);
+void arenaReset(ARENA *);
+void arenaDestroy(ARENA *);
+void useArena(ARENA *);
+void* schedAlloc(size_t);
+void* schedCalloc(size_t, size_t);
+void schedFree(void *);
+GANTT* ganttAlloc();
+void sinkInit(GANTT_SINK *, GANTT_RLE *, int);
+void sinkEmit(GANTT_SINK *, int, SCHED_TIME, SCHED_TIME);
+GANTT* sinkClose(GANTT_SINK *);
+
+// WORKLOAD struct related functions
+WORKLOAD* getWorkload(PROCESS *, int);
+void sortWorkload(WORKLOAD *, SORT_KEY);
+void storeWorkload(WORKLOAD *, PROCESS *);
+void destroyWorkload(WORKLOAD *);
+
+// Selection primitives of the algorithms
+int selectMinBurst(PROCESS_HOT *, int *, int, int);
+int selectMaxBurst(PROCESS_HOT *, int *, int, int);
+int selectMaxResponseRatio(PROCESS_HOT *, int *, int, int, SCHED_TIME);
+int selectShortestRemaining(PROCESS_HOT *, int);
+int selectLongestRemaining(PROCESS_HOT *, int, int *);
+void admitArrivals(PROCESS_HOT *, int, SCHED_TIME, int *, int *, int *, int *);
 
 // *** Non-Preemptive Scheduling Algorithms ***
 GANTT* getGanttFCFS(PROCESS *, int);
@@ -64,11 +859,133 @@ GANTT* getGanttLJF(PROCESS *, int);
 GANTT* getGanttSRTF(PROCESS *, int);
 GANTT* getGanttPriorityPreemptive(PROCESS *, int);
 GANTT* getGanttLRTF(PROCESS *, int);
-GANTT* getGanttRoundRobin(PROCESS *, int, int);
+GANTT* getGanttRoundRobin(PROCESS *, int, SCHED_TIME);
+
+// Run any of the algorithms above
+GANTT* getGanttPolicy(SCHED_POLICY, PROCESS *, int, SCHED_TIME);
+int getStatsPolicy(SCHED_POLICY, PROCESS *, int, SCHED_TIME, SCHED_SUMMARY *);
+
+// Non-preemptive algorithms writing into one preallocated block
+void ganttBufferInit(GANTT_BUFFER *);
+GANTT* getGanttBuffered(SCHED_POLICY, PROCESS *, int, GANTT_BUFFER *);
+GANTT* ganttCopy(GANTT *);
+void ganttBufferDestroy(GANTT_BUFFER *);
+
+// Specialized simulation cores, writing to a GANTT_SINK (policySimulators[policy] selects one at run time)
+GANTT* simulateFCFS(PROCESS *, int, SCHED_TIME, GANTT_SINK *);
+GANTT* simulateSJF(PROCESS *, int, SCHED_TIME, GANTT_SINK *);
+GANTT* simulateHRRN(PROCESS *, int, SCHED_TIME, GANTT_SINK *);
+GANTT* simulatePriority(PROCESS *, int, SCHED_TIME, GANTT_SINK *);
+GANTT* simulateLJF(PROCESS *, int, SCHED_TIME, GANTT_SINK *);
+GANTT* simulateSRTF(PROCESS *, int, SCHED_TIME, GANTT_SINK *);
+GANTT* simulatePriorityPreemptive(PROCESS *, int, SCHED_TIME, GANTT_SINK *);
+GANTT* simulateLRTF(PROCESS *, int, SCHED_TIME, GANTT_SINK *);
+GANTT* simulateRoundRobin(PROCESS *, int, SCHED_TIME, GANTT_SINK *);
+
+// *** Parallel simulation (work-stealing thread pool) ***
+POOL* createPool(int, int);
+void poolSubmit(POOL *, JOB *);
+void poolWait(POOL *);
+void poolRelease(POOL *);
+void destroyPool(POOL *);
 
 // GANTT struct related functions
 void displayGantt(GANTT *);
 void destroyGantt(GANTT *);
+int exportChromeTrace(char *, GANTT *, PROCESS *, int);
+
+// Compressed GANTT chart
+GANTT_RLE* createGanttRLE();
+int rleAppend(GANTT_RLE *, int, SCHED_TIME, SCHED_TIME);
+void rleBegin(GANTT_RLE *, GANTT_CURSOR *);
+int rleNext(GANTT_CURSOR *, GANTT *);
+long long rleSeek(GANTT_RLE *, SCHED_TIME, GANTT_CURSOR *);
+GANTT_RLE* ganttCompress(GANTT *);
+GANTT* ganttDecompress(GANTT_RLE *);
+GANTT_RLE* getGanttCompressed(SCHED_POLICY, PROCESS *, int, SCHED_TIME);
+void displayGanttRLE(GANTT_RLE *);
+void destroyGanttRLE(GANTT_RLE *);
+
+// Time-window queries over a GANTT chart
+GANTT_INDEX* createGanttIndex(GANTT *);
+GANTT_INDEX* createGanttIndexRLE(GANTT_RLE *);
+long long ganttIndexAt(GANTT_INDEX *, SCHED_TIME);
+long long ganttIndexRange(GANTT_INDEX *, SCHED_TIME, SCHED_TIME, long long *);
+SCHED_TIME ganttIndexBusy(GANTT_INDEX *, SCHED_TIME, SCHED_TIME);
+int ganttUtilization(GANTT_INDEX *, SCHED_TIME, SCHED_TIME, int, double *);
+void destroyGanttIndex(GANTT_INDEX *);
+
+// *** I/O Burst Scheduling ***
+int getProcessesFileIO(char *, IO_PROCESS **);
+GANTT* getGanttIO(IO_PROCESS *, int, SCHED_POLICY, SCHED_TIME, GANTT **);
+void displayProcessesIO(IO_PROCESS *, int, GANTT *, GANTT *);
+void destroyProcessesIO(IO_PROCESS *, int);
+
+// Binary heap of process indices
+void heapInit(HEAP *, int (*)(void *, int, int), void *);
+void heapPush(HEAP *, int);
+int heapPop(HEAP *);
+void heapDestroy(HEAP *);
+
+// Priority run queue
+void runqInit(RUNQUEUE *, PROCESS_HOT *, int);
+void runqPush(RUNQUEUE *, int);
+int runqPeek(RUNQUEUE *);
+int runqPop(RUNQUEUE *);
+void runqDestroy(RUNQUEUE *);
+
+// Event queue (heap or timing wheel)
+void eventInit(EVENT_QUEUE *, EVENTQ_KIND, int (*)(void *, int, int), void *);
+int eventPush(EVENT_QUEUE *, int, SCHED_TIME);
+SCHED_TIME eventNextTime(EVENT_QUEUE *);
+int eventPop(EVENT_QUEUE *);
+int eventQueued(EVENT_QUEUE *, int *);
+void eventDestroy(EVENT_QUEUE *);
+
+// *** Priority Scheduling with Aging ***
+GANTT* getGanttPriorityAging(PROCESS *, int, SCHED_TIME);
+GANTT* getGanttPriorityPreemptiveAging(PROCESS *, int, SCHED_TIME);
+void displayStarvation(PROCESS *, int);
+
+// *** Incremental (online) Scheduling ***
+SCHEDULER* createScheduler(SCHED_POLICY, SCHED_TIME);
+int schedulerUseEventQueue(SCHEDULER *, EVENTQ_KIND);
+int schedulerSubmit(SCHEDULER *, PROCESS);
+void schedulerAdvanceTo(SCHEDULER *, SCHED_TIME);
+GANTT* schedulerPollSegments(SCHEDULER *);
+int schedulerSaveFile(SCHEDULER *, FILE *);
+SCHEDULER* schedulerLoadFile(FILE *);
+int schedulerSave(SCHEDULER *, char *);
+SCHEDULER* schedulerLoad(char *);
+int schedulerSetCheckpoint(SCHEDULER *, char *, SCHED_TIME);
+void destroyScheduler(SCHEDULER *);
+
+// *** Hierarchical Fair-Share Scheduling (control groups) ***
+int getProcessesFileGroups(char *, PROCESS **, int **, CGROUP **, int *);
+GANTT* getGanttGroups(PROCESS *, int, int *, CGROUP *, int, SCHED_TIME);
+void displayGroups(CGROUP *, int, GANTT *);
+void destroyGroups(CGROUP *);
+
+// *** Heterogeneous multiprocessor (per-core speed factors) ***
+int getCoresFile(char *, CPU_CORE **);
+GANTT** getGanttCores(PROCESS *, int, SCHED_POLICY, SCHED_TIME, CPU_CORE *, int, PLACEMENT, int *);
+void displayCores(CPU_CORE *, int, PROCESS *, PROCESS *, int);
+void destroyGanttCores(GANTT **, int);
+
+// Context switch cost model
+GANTT* applySwitchCost(GANTT *, PROCESS *, int, SWITCH_COST);
+void displaySwitchStats(GANTT *);
+
+// Energy and DVFS model
+int getEnergyModelFile(char *, ENERGY_MODEL *);
+int getEnergy(GANTT *, PROCESS *, int, ENERGY_MODEL *, DVFS_POLICY, ENERGY_REPORT *);
+void displayEnergy(ENERGY_REPORT *, int);
+
+// Instrumentation counters (-DSCHED_STATS)
+void schedStatsFlush();
+void getSchedStats(SCHED_COUNTERS *);
+void resetSchedStats();
+void displaySchedStats();
 
 
 PROCESS* getProcesses(int n) {
@@ -102,12 +1019,12 @@ PROCESS* getProcesses(int n) {
         process[i].pid = i;
         process[i].priority = -1;
         printf("\nProcess %d:-", i);
-        int check = -1;
+        SCHED_TIME check = -1;
 
         do
         {
             printf("\n\tArrival time: ");           // accept arrival time
-            scanf("%d", &check);
+            scanf(TIME_FMT, &check);
             if(check < 0)
                 printf("\nInvalid value! Enter again!\n");
         } while(check < 0);
@@ -117,7 +1034,7 @@ PROCESS* getProcesses(int n) {
         do
         {
             printf("\n\tBurst time: ");             // accept burst time
-            scanf("%d", &check);
+            scanf(TIME_FMT, &check);
             if(check < 0)
                 printf("\nInvalid value! Enter again!\n");
         } while(check < 0);
@@ -157,12 +1074,12 @@ PROCESS* getProcessesPriority(int n) {
     for(int i = 0; i < n; ++i) {
         process[i].pid = i;
         printf("\nProcess %d:-", i);
-        int check = -1;
+        SCHED_TIME check = -1;
 
         do
         {
             printf("\n\tArrival time: ");           // accept arrival time
-            scanf("%d", &check);
+            scanf(TIME_FMT, &check);
             if(check < 0)
                 printf("\nInvalid value! Enter again!\n");
         } while(check < 0);
@@ -171,7 +1088,7 @@ PROCESS* getProcessesPriority(int n) {
         do
         {
             printf("\n\tBurst time: ");             // accept burst time
-            scanf("%d", &check);
+            scanf(TIME_FMT, &check);
             if(check < 0)
                 printf("\nInvalid value! Enter again!\n");
         } while(check < 0);
@@ -181,11 +1098,11 @@ PROCESS* getProcessesPriority(int n) {
         do
         {
             printf("\n\tPriority: ");             // accept burst time
-            scanf("%d", &check);
+            scanf(TIME_FMT, &check);
             if(check < 0)
                 printf("\nInvalid value! Enter again!\n");
         } while(check < 0);
-        process[i].priority = check;
+        process[i].priority = (int)check;
     }
     return process;
 }
@@ -220,7 +1137,8 @@ int getProcessesFile(char *fileName, PROCESS **process) {
         return -1;
     }
 
-    int n = 0, check_at, check_bt;
+    int n = 0;
+    SCHED_TIME check_at, check_bt;
 
     fscanf(fptr, "%d", &n);
     if(n < 1) {
@@ -239,7 +1157,7 @@ int getProcessesFile(char *fileName, PROCESS **process) {
     for (int i = 0; i < n; ++i) {
         check_at = check_bt = -1;
 
-        if(fscanf(fptr, "%d %d", &check_at, &check_bt) != 2) {
+        if(fscanf(fptr, TIME_FMT " " TIME_FMT, &check_at, &check_bt) != 2) {
             printf("\nIncomplete data in the file at process %d!\n", i);
             fclose(fptr);
             *process = NULL;
@@ -293,7 +1211,8 @@ int getProcessesFilePriority(char *fileName, PROCESS **process) {
         return -1;
     }
 
-    int n = 0, check_at, check_bt, check_p;
+    int n = 0, check_p;
+    SCHED_TIME check_at, check_bt;
 
     fscanf(fptr, "%d", &n);
     if(n < 1) {
@@ -312,7 +1231,7 @@ int getProcessesFilePriority(char *fileName, PROCESS **process) {
     for (int i = 0; i < n; ++i) {
         check_at = check_bt = check_p = -1;
 
-        if(fscanf(fptr, "%d %d %d", &check_at, &check_bt, &check_p) != 3) {
+        if(fscanf(fptr, TIME_FMT " " TIME_FMT " %d", &check_at, &check_bt, &check_p) != 3) {
             printf("\nIncomplete data in the file at process %d!\n", i);
             fclose(fptr);
             *process = NULL;
@@ -361,13 +1280,13 @@ void displayProcesses(PROCESS *process, int n) {
         return;
     }
 
-    float waitSum = 0, tatSum = 0;
+    long long waitSum = 0, tatSum = 0;              // exact sums, divided once at the end
     printf("\n\nWaiting time and Turn-around time:-");
     if(process[0].priority == -1) {
         printf("\nPID\tWait\tTAT\n------------------------");
         for(int i = 0; i < n; i++)
         {
-            printf("\nP%d\t%d\t%d", process[i].pid, process[i].wait_time, process[i].turnaround_time);
+            printf("\nP%d\t" TIME_FMT "\t" TIME_FMT, process[i].pid, process[i].wait_time, process[i].turnaround_time);
             waitSum += process[i].wait_time;
             tatSum += process[i].turnaround_time;
         }
@@ -376,14 +1295,17 @@ void displayProcesses(PROCESS *process, int n) {
         printf("\nPrty\tPID\tWait\tTAT\n--------------------------------");
         for(int i = 0; i < n; i++)
         {
-            printf("\n%d\tP%d\t%d\t%d", process[i].priority, process[i].pid, process[i].wait_time, process[i].turnaround_time);
+            printf("\n%d\tP%d\t" TIME_FMT "\t" TIME_FMT, process[i].priority, process[i].pid, process[i].wait_time, process[i].turnaround_time);
             waitSum += process[i].wait_time;
             tatSum += process[i].turnaround_time;
         }
     }
 
-    printf("\n\nAverage Waiting time: %.2f", waitSum/n);
-    printf("\nAverage Turn-around time: %.2f", tatSum/n);
+    printf("\n\nAverage Waiting time: %.2f", (double)waitSum/n);
+    printf("\nAverage Turn-around time: %.2f", (double)tatSum/n);
+#ifdef SCHED_STATS
+    displaySchedStats();
+#endif
     printf("\n----------------------------------------------------------------\n");
 }
 
@@ -409,1174 +1331,5411 @@ void destroyProcesses(PROCESS *process) {
     process = NULL;
 }
 
-GANTT* getGanttFCFS(PROCESS *process, int n) {
-    
-/*
+int getBatchFile(char *fileName, PROCESS **process, int **offset) {
+    /*
         INTRODUCTION:
-            Simulates First-Come First-Serve (FCFS) scheduling.
+            Reads many independent workloads from one file.
 
         INPUT PARAMETERS:
-            - process (PROCESS*): process array.
-            - n (int): number of processes.
+            - fileName (char*): path to file / file name.
+            - process (PROCESS**): pointer to array of PROCESS structs (to be allocated).
+            - offset (int**): pointer to array of workload offsets (to be allocated).
 
         OUTPUT PARAMETERS:
-            - Constructs GANTT chart linked list.
+            - Allocates *process with the processes of all workloads, one after another.
+            - Allocates *offset, workload k is (*process)[(*offset)[k]] ... (*process)[(*offset)[k+1] - 1].
 
         RETURN VALUES:
-            - (GANTT*): pointer to GANTT chart head.
+            - (int): number of workloads read from the file, -1 if any error.
 
         APPROACH:
-            - Sort processes by arrival time.
-            - Execute processes in order, updating GANTT linked list.
+            - Read number of workloads, then for every workload the number of processes (n)
+              followed by n lines of arrival time, burst time and priority.
+            - Grow the process array geometrically while reading, pid restarts at 0 in every workload.
     */
 
-    if(n < 1 || !process) {
-        printf("\nInvalid number of Processes!\n");
-        return NULL;
+    *process = NULL;
+    *offset = NULL;
+
+    FILE *fptr = fopen(fileName, "r");
+    if(!fptr) {
+        printf("\nFailed to open the file!\n");
+        return -1;
     }
 
-    if(process) {
-        for(int i = 0; i < n-1; i++)                // sort according to arrival time
-        {
-            for(int j = i+1; j < n; j++)
-            {
-                if(process[i].arrive_time > process[j].arrive_time)
-                {
-                    PROCESS t = process[i];
-                    process[i] = process[j];
-                    process[j] = t;
-                }
-            }
-        }
-    }
-    else {
-        printf("\nFailed to read the processes!\n");
-        return NULL;
-    }
-
-    GANTT *ghead = NULL, *gnew = NULL, *gcurr = NULL;
-
-    if(process[0].arrive_time != 0)
-    {
-        ghead = (GANTT *)malloc(sizeof(GANTT));
-        ghead->pid = -1;                        // -1 for IDLE
-        ghead->start_time = 0;
-        ghead->finish_time = process[0].arrive_time;
-        ghead->next = NULL;
-        gcurr = ghead;
+    int count = 0, total = 0, capacity = 0;
+    if(fscanf(fptr, "%d", &count) != 1 || count < 1) {
+        printf("\nInvalid number of workloads!\n");
+        fclose(fptr);
+        return -1;
     }
 
-    for(int i = 0; i < n; i++)
-    {
-        gnew = (GANTT *)malloc(sizeof(GANTT));
+    *offset = (int *)malloc((count+1)*sizeof(int));
+    (*offset)[0] = 0;
 
-        if(!ghead)
-        {
-            gnew->pid = process[i].pid;
-            gnew->start_time = 0;
-            gnew->finish_time = process[i].burst_time;
-            gnew->next = NULL;
-            ghead = gcurr = gnew;
+    int k;
+    for(k = 0; k < count; ++k) {
+        int n = 0;
+        if(fscanf(fptr, "%d", &n) != 1 || n < 1) {
+            printf("\nInvalid number of processes in workload %d!\n", k);
+            break;
+        }
 
-            process[i].wait_time = 0;
-            process[i].turnaround_time = gcurr->finish_time - process[i].arrive_time;
+        if(total + n > capacity) {
+            capacity = (total + n > 2*capacity) ? total + n : 2*capacity;
+            *process = (PROCESS *)realloc(*process, capacity*sizeof(PROCESS));
         }
-        else
-        {
-            if(process[i].arrive_time <= gcurr->finish_time)
-            {
-                gnew->pid = process[i].pid;
-                gnew->start_time = gcurr->finish_time;
-                gnew->finish_time = gnew->start_time + process[i].burst_time;
-                gnew->next = NULL;
-                gcurr->next = gnew;
-                gcurr = gnew;
 
-                process[i].wait_time = gcurr->start_time - process[i].arrive_time;
-                process[i].turnaround_time = gcurr->finish_time - process[i].arrive_time;
+        for(int i = 0; i < n; ++i) {
+            SCHED_TIME check_at = -1, check_bt = -1;
+            int check_p = -1;
+
+            if(fscanf(fptr, TIME_FMT " " TIME_FMT " %d", &check_at, &check_bt, &check_p) != 3) {
+                printf("\nIncomplete data in the file at workload %d, process %d!\n", k, i);
+                n = -1;
+                break;
             }
-            else
-            {
-                gnew->pid = -1;                 // System is IDLE
-                gnew->start_time = gcurr->finish_time;
-                gnew->finish_time = process[i].arrive_time;
-                gnew->next = NULL;
-                gcurr->next = gnew;
-                gcurr = gnew;
-                i--;
+            if(check_at < 0 || check_bt < 0 || check_p < 0) {
+                printf("\nInvalid value for arrival/burst time/priority at workload %d, process %d!\n", k, i);
+                n = -1;
+                break;
             }
-        }        
+
+            PROCESS *p = &(*process)[total + i];
+            p->pid = i;
+            p->arrive_time = check_at;
+            p->burst_time = p->initial_burst = check_bt;
+            p->priority = check_p;
+            p->wait_time = p->turnaround_time = 0;
+        }
+        if(n < 0) break;
+
+        total += n;
+        (*offset)[k+1] = total;
     }
-    return ghead;
+
+    fclose(fptr);
+    if(k == count) return count;
+
+    free(*process);
+    free(*offset);
+    *process = NULL;
+    *offset = NULL;
+    return -1;
 }
 
-GANTT* getGanttSJF(PROCESS *process, int n) {
+void arenaInit(ARENA *arena, size_t size) {
     /*
         INTRODUCTION:
-            Simulates Shortest Job First (SJF) non-preemptive scheduling.
+            Initializes a scratch memory arena.
 
         INPUT PARAMETERS:
-            - process (PROCESS*): process array.
-            - n (int): number of processes.
+            - arena (ARENA*): arena to initialize.
+            - size (size_t): initial size in bytes (grows when exceeded).
 
         OUTPUT PARAMETERS:
-            - Constructs GANTT chart linked list.
+            - Allocates the first block of arena.
 
         RETURN VALUES:
-            - (GANTT*): pointer to GANTT chart head.
-
-        APPROACH:
-            - Sort processes by arrival time, or on burst time if arrival times are same.
-            - Select shortest available job at each time point.
-            - Update GANTT chart and process stats.
+            - None.
     */
 
-    if(n < 1 || !process) {
-        printf("\nInvalid number of Processes!\n");
-        return NULL;
-    }
-
-    if(process) {
-        for(int i = 0; i < n-1; i++)                // sort according to arrival time
-        {
-            for(int j = i+1; j < n; j++)
-            {
-                if(process[i].arrive_time > process[j].arrive_time)
-                {
-                    PROCESS t = process[i];
-                    process[i] = process[j];
-                    process[j] = t;
-                    continue;
-                }
-                if(process[i].arrive_time == process[j].arrive_time) {          // if same arrival time, sort on burst time
-                    if(process[i].burst_time > process[j].burst_time) {
-                        PROCESS t = process[i];
-                        process[i] = process[j];
-                        process[j] = t;
-                    }
-                }
-            }
-        }
-    }
-    else {
-        printf("\nFailed to read the processes!\n");
-        return NULL;
-    }
-
-    GANTT *ghead = NULL, *gnew = NULL, *gcurr = NULL;
-
-    if(process[0].arrive_time != 0)
-    {
-        ghead = (GANTT *)malloc(sizeof(GANTT));
-        ghead->pid = -1;                        // -1 for IDLE
-        ghead->start_time = 0;
-        ghead->finish_time = process[0].arrive_time;
-        ghead->next = NULL;
-        gcurr = ghead;
-    }
-
-    for(int i = 0; i < n; ++i) {
-        int mini = -1;
-
-        gnew = (GANTT *)malloc(sizeof(GANTT));
-
-        if(!ghead) {
-            gnew->pid = process[i].pid;
-            gnew->start_time = 0;
-            gnew->finish_time = process[i].burst_time;
-            gnew->next = NULL;
-            ghead = gcurr = gnew;
+    if(size < 4096) size = 4096;
+    arena->base = (char *)malloc(size);
+    arena->size = size;
+    arena->used = 16;                               // header: link to the previous block
+    arena->total = 0;
+    arena->spill = NULL;
+}
 
-            process[i].wait_time = 0;
-            process[i].turnaround_time = gcurr->finish_time - process[i].arrive_time;
-        }
-        else {
-            if(process[i].arrive_time <= gcurr->finish_time) {
-                int j = i+1;
-                mini = i;
+void* arenaAlloc(ARENA *arena, size_t bytes) {
+    /*
+        INTRODUCTION:
+            Allocates memory from a scratch memory arena.
 
-                while(j < n && process[j].arrive_time <= gcurr->finish_time) j++;
+        INPUT PARAMETERS:
+            - arena (ARENA*): arena to allocate from.
+            - bytes (size_t): number of bytes.
 
-                for(int k = i+1; k < j; ++k) {
-                    if(process[k].burst_time < process[mini].burst_time) {mini = k;}
-                }
-                if(mini != i) {
-                    PROCESS temp = process[mini];
-                    for (int k = mini; k > i; --k) {
-                        process[k] = process[k - 1];
-                    }
-                    process[i] = temp;
-                }
+        OUTPUT PARAMETERS:
+            - Moves the current block to the spill list if it is full.
 
-                gnew->pid = process[i].pid;
-                gnew->start_time = gcurr->finish_time;
-                gnew->finish_time = gnew->start_time + process[i].burst_time;
-                gnew->next = NULL;
-                gcurr->next = gnew;
-                gcurr = gnew;
+        RETURN VALUES:
+            - (void*): 16-byte aligned memory, valid until the next arenaReset / arenaDestroy.
 
-                process[i].wait_time = gcurr->start_time - process[i].arrive_time;
-                process[i].turnaround_time = gcurr->finish_time - process[i].arrive_time;
+        APPROACH:
+            - Bump the offset of the current block.
+            - When the block is full, start a block of twice the size (or large enough for the request);
+              the old block stays valid until the arena is reset.
+    */
 
-            }
-            else {
-                gnew->pid = -1;                 // System is IDLE
-                gnew->start_time = gcurr->finish_time;
-                gnew->finish_time = process[i].arrive_time;
-                gnew->next = NULL;
-                gcurr->next = gnew;
-                gcurr = gnew;
-                i--;
-            }
-        }
+    bytes = (bytes + 15) & ~(size_t)15;
+    if(arena->used + bytes > arena->size) {
+        size_t size = 2*arena->size;
+        if(size < bytes + 16) size = bytes + 16;
+
+        char *block = (char *)malloc(size);
+        if(!block) return NULL;
+        *(char **)arena->base = arena->spill;
+        arena->spill = arena->base;
+        arena->base = block;
+        arena->size = size;
+        arena->used = 16;
     }
-    return ghead;
+
+    void *ptr = arena->base + arena->used;
+    arena->used += bytes;
+    arena->total += bytes;
+    return ptr;
 }
 
-GANTT* getGanttHRRN(PROCESS *process, int n) {
+void arenaReset(ARENA *arena) {
     /*
         INTRODUCTION:
-            Simulates Highest Response Ratio Next (HRRN) scheduling.
+            Releases everything allocated from a scratch memory arena.
 
         INPUT PARAMETERS:
-            - process (PROCESS*): process array.
-            - n (int): number of processes.
+            - arena (ARENA*): arena to reset.
 
         OUTPUT PARAMETERS:
-            - Constructs GANTT chart linked list.
+            - Frees the spilled blocks.
 
         RETURN VALUES:
-            - (GANTT*): pointer to GANTT chart head.
+            - None.
 
         APPROACH:
-            - Sort processes on arrival time, or on burst time if arrival times are same.
-            - At each step, pick process with highest response ratio.
-            - Update GANTT chart and process stats.
+            - If the arena had to grow, replace its blocks by one block large enough for everything
+              allocated since the last reset, so that the next workload of the same size does not
+              call malloc at all.
     */
 
-    if(n < 1 || !process) {
-        printf("\nInvalid number of Processes!\n");
-        return NULL;
-    }
-
-    if(process) {
-        for(int i = 0; i < n-1; i++)                // sort according to arrival time
-        {
-            for(int j = i+1; j < n; j++)
-            {
-                if(process[i].arrive_time > process[j].arrive_time)
-                {
-                    PROCESS t = process[i];
-                    process[i] = process[j];
-                    process[j] = t;
-                    continue;
-                }
-
-                if(process[i].arrive_time == process[j].arrive_time) {          // if same arrival time, sort on burst time
-                    if(process[i].burst_time > process[j].burst_time) {
-                        PROCESS t = process[i];
-                        process[i] = process[j];
-                        process[j] = t;
-                    }
-                }
-            }
+    if(arena->spill) {
+        while(arena->spill) {
+            char *prev = *(char **)arena->spill;
+            free(arena->spill);
+            arena->spill = prev;
+        }
+        if(arena->size < arena->total + 16) {
+            free(arena->base);
+            arena->size = arena->total + 16;
+            arena->base = (char *)malloc(arena->size);
         }
     }
-    else {
-        printf("\nFailed to read the processes!\n");
-        return NULL;
-    }
-
-    GANTT *ghead = NULL, *gnew = NULL, *gcurr = NULL;
-
-    if(process[0].arrive_time != 0)
-    {
-        ghead = (GANTT *)malloc(sizeof(GANTT));
-        ghead->pid = -1;                        // -1 for IDLE
-        ghead->start_time = 0;
-        ghead->finish_time = process[0].arrive_time;
-        ghead->next = NULL;
-        gcurr = ghead;
-    }
+    arena->used = 16;
+    arena->total = 0;
+}
 
-    for(int i = 0; i < n; ++i) {
-        int mini = -1;
-        float max_hrrn = -1.0;
+void arenaDestroy(ARENA *arena) {
+    /*
+        INTRODUCTION:
+            Frees all memory of a scratch memory arena.
 
-        gnew = (GANTT *)malloc(sizeof(GANTT));
+        INPUT PARAMETERS:
+            - arena (ARENA*): arena to free.
 
-        if(!ghead) {
-            gnew->pid = process[i].pid;
-            gnew->start_time = 0;
-            gnew->finish_time = process[i].burst_time;
-            gnew->next = NULL;
-            ghead = gcurr = gnew;
+        OUTPUT PARAMETERS:
+            - Frees every block, unbinds the arena if the calling thread uses it.
 
-            process[i].wait_time = 0;
-            process[i].turnaround_time = gcurr->finish_time - process[i].arrive_time;
-        }
+        RETURN VALUES:
+            - None.
+    */
 
-        else {
-            if(process[i].arrive_time <= gcurr->finish_time) {
-                mini = i;
-                int j = i+1;
-                while(j < n && process[j].arrive_time <= gcurr->finish_time) ++j;
-
-                for(int k = i; k < j; ++k) {
-                    float wait = (float)(gcurr->finish_time - process[k].arrive_time);
-                    float hrrn = 1+ (float)(wait / process[k].burst_time);
-                    if(hrrn > max_hrrn) {
-                        mini = k;
-                        max_hrrn = hrrn;
-                    }
-                }
+    arenaReset(arena);
+    free(arena->base);
+    arena->base = NULL;
+    arena->size = arena->used = 0;
+    if(schedArena == arena) schedArena = NULL;
+}
 
-                if(mini != i) {
-                    PROCESS temp = process[mini];
-                    for (int k = mini; k > i; --k) {
-                        process[k] = process[k - 1];
-                    }
-                    process[i] = temp;
-                }
+void useArena(ARENA *arena) {
+    // Binds arena to the calling thread (NULL to go back to malloc / free)
+    schedArena = arena;
+}
 
-                gnew->pid = process[i].pid;
-                gnew->start_time = gcurr->finish_time;
-                gnew->finish_time = gnew->start_time + process[i].burst_time;
-                gnew->next = NULL;
-                gcurr->next = gnew;
-                gcurr = gnew;
+void* schedAlloc(size_t bytes) {
+    // Allocates from the arena of the calling thread, or with malloc if none is bound
+    return schedArena ? arenaAlloc(schedArena, bytes) : malloc(bytes);
+}
 
-                process[i].wait_time = gcurr->start_time - process[i].arrive_time;
-                process[i].turnaround_time = gcurr->finish_time - process[i].arrive_time;
-            }
+void* schedCalloc(size_t count, size_t bytes) {
+    // schedAlloc of zero-filled memory
+    if(!schedArena) return calloc(count, bytes);
+    void *ptr = arenaAlloc(schedArena, count*bytes);
+    if(ptr) memset(ptr, 0, count*bytes);
+    return ptr;
+}
 
-            else {
-                gnew->pid = -1;                 // System is IDLE
-                gnew->start_time = gcurr->finish_time;
-                gnew->finish_time = process[i].arrive_time;
-                gnew->next = NULL;
-                gcurr->next = gnew;
-                gcurr = gnew;
-                i--;
-            }
-        }
-    }
-    return ghead;
+void schedFree(void *ptr) {
+    // Frees memory from schedAlloc (arena memory is released by arenaReset)
+    if(!schedArena) free(ptr);
 }
 
-GANTT* getGanttPriority(PROCESS *process, int n) {
+WORKLOAD* getWorkload(PROCESS *process, int n) {
     /*
         INTRODUCTION:
-            Simulates non-preemptive priority scheduling.
+            Splits a process array into a struct-of-arrays WORKLOAD.
 
         INPUT PARAMETERS:
             - process (PROCESS*): process array.
             - n (int): number of processes.
 
         OUTPUT PARAMETERS:
-            - Constructs GANTT chart linked list.
+            - None.
 
         RETURN VALUES:
-            - (GANTT*): pointer to GANTT chart head.
+            - (WORKLOAD*): pointer to the new workload.
 
         APPROACH:
-            - Sort processes on arrival time, or on priority if arrival times are same.
-            - Pick available process with highest priority.
-            - Execute, update GANTT chart.
+            - Allocate the workload and its arrays.
+            - Copy arrival, burst and priority into the packed hot array, pid and initial burst
+              into the cold arrays, and set order to the identity.
     */
 
-    if(n < 1 || !process) {
-        printf("\nInvalid number of Processes!\n");
-        return NULL;
-    }
-
-    if(process) {
-        for(int i = 0; i < n-1; i++)                // sort according to arrival time
-        {
-            for(int j = i+1; j < n; j++)
-            {
-                if(process[i].arrive_time > process[j].arrive_time)
-                {
-                    PROCESS t = process[i];
-                    process[i] = process[j];
-                    process[j] = t;
-                    continue;
-                }
-
-                if(process[i].arrive_time == process[j].arrive_time) {          // if same arrival time, sort on priority
-                    if(process[i].priority > process[j].priority) {
-                        PROCESS t = process[i];
-                        process[i] = process[j];
-                        process[j] = t;
-                    }
-                }
-            }
-        }
-    }
-    else {
-        printf("\nFailed to read the processes!\n");
-        return NULL;
+    WORKLOAD *w = (WORKLOAD *)schedAlloc(sizeof(WORKLOAD));
+    w->n = n;
+    w->hot = (PROCESS_HOT *)schedAlloc(n*sizeof(PROCESS_HOT));
+    w->out = (PROCESS_OUT *)schedCalloc(n, sizeof(PROCESS_OUT));
+    w->pid = (int *)schedAlloc(n*sizeof(int));
+    w->initial_burst = (SCHED_TIME *)schedAlloc(n*sizeof(SCHED_TIME));
+    w->order = (int *)schedAlloc(n*sizeof(int));
+
+    for(int i = 0; i < n; i++) {
+        w->hot[i].arrive_time = process[i].arrive_time;
+        w->hot[i].burst_time = process[i].burst_time;
+        w->hot[i].priority = process[i].priority;
+        w->pid[i] = process[i].pid;
+        w->initial_burst[i] = process[i].initial_burst;
+        w->order[i] = i;
     }
+    return w;
+}
 
+void sortWorkload(WORKLOAD *w, SORT_KEY secondary) {
+    /*
+        INTRODUCTION:
+            Sorts a workload on arrival time, or on a secondary key if arrival times are same.
 
-    GANTT *ghead = NULL, *gnew = NULL, *gcurr = NULL;
-
-    if(process[0].arrive_time != 0)
-    {
-        ghead = (GANTT *)malloc(sizeof(GANTT));
-        ghead->pid = -1;                        // -1 for IDLE
-        ghead->start_time = 0;
-        ghead->finish_time = process[0].arrive_time;
-        ghead->next = NULL;
-        gcurr = ghead;
-    }
-
-    for(int i = 0; i < n; ++i) {
-        int mini = -1;
+        INPUT PARAMETERS:
+            - w (WORKLOAD*): workload.
+            - secondary (SORT_KEY): key used when arrival times are same.
 
-        gnew = (GANTT *)malloc(sizeof(GANTT));
+        OUTPUT PARAMETERS:
+            - Reorders the arrays of the workload, order is reset to the identity.
 
-        if(!ghead) {
-            gnew->pid = process[i].pid;
-            gnew->start_time = 0;
-            gnew->finish_time = process[i].burst_time;
-            gnew->next = NULL;
-            ghead = gcurr = gnew;
+        RETURN VALUES:
+            - None.
 
-            process[i].wait_time = 0;
-            process[i].turnaround_time = gcurr->finish_time - process[i].arrive_time;
-        }
-        else {
-            if(process[i].arrive_time <= gcurr->finish_time) {
-                mini = i;
-                int j = i+1;
-                while(j < n && process[j].arrive_time <= gcurr->finish_time) ++j;
-
-                for(int k = i; k < j; ++k) {
-                    if(process[mini].priority > process[k].priority) {
-                        mini = k;
-                    }
-                }
+        APPROACH:
+            - Same exchange sort (and so the same order among equal keys) the algorithms always used,
+              but it swaps 4-byte indices in order instead of whole PROCESS records.
+            - Then move every record to its sorted position once, so the selection loops scan
+              the hot array sequentially.
+    */
 
-                if(mini != i) {
-                    PROCESS temp = process[mini];
-                    for (int k = mini; k > i; --k) {
-                        process[k] = process[k - 1];
-                    }
-                    process[i] = temp;
-                }
+    int n = w->n, *order = w->order;
+    PROCESS_HOT *hot = w->hot;
 
-                gnew->pid = process[i].pid;
-                gnew->start_time = gcurr->finish_time;
-                gnew->finish_time = gnew->start_time + process[i].burst_time;
-                gnew->next = NULL;
-                gcurr->next = gnew;
-                gcurr = gnew;
+    for(int i = 0; i < n-1; i++)                    // sort according to arrival time
+    {
+        PROCESS_HOT a = hot[order[i]];              // record at position i, kept in a register
 
-                process[i].wait_time = gcurr->start_time - process[i].arrive_time;
-                process[i].turnaround_time = gcurr->finish_time - process[i].arrive_time;
+        for(int j = i+1; j < n; j++)
+        {
+            PROCESS_HOT *b = &hot[order[j]];
+            int swap = 0;
+
+            if(a.arrive_time > b->arrive_time) swap = 1;
+            else if(a.arrive_time == b->arrive_time) {          // if same arrival time, sort on secondary key
+                if(secondary == SORT_BURST) swap = a.burst_time > b->burst_time;
+                if(secondary == SORT_BURST_DESC) swap = a.burst_time < b->burst_time;
+                if(secondary == SORT_PRIORITY) swap = a.priority > b->priority;
             }
 
-            else {
-                gnew->pid = -1;                 // System is IDLE
-                gnew->start_time = gcurr->finish_time;
-                gnew->finish_time = process[i].arrive_time;
-                gnew->next = NULL;
-                gcurr->next = gnew;
-                gcurr = gnew;
-                i--;
+            if(swap) {
+                int t = order[i];
+                order[i] = order[j];
+                order[j] = t;
+                a = *b;
             }
         }
     }
-    return ghead;
+
+    PROCESS_HOT *s_hot = (PROCESS_HOT *)schedAlloc(n*sizeof(PROCESS_HOT));
+    int *s_pid = (int *)schedAlloc(n*sizeof(int));
+    SCHED_TIME *s_burst = (SCHED_TIME *)schedAlloc(n*sizeof(SCHED_TIME));
+
+    for(int i = 0; i < n; i++) {
+        s_hot[i] = hot[order[i]];
+        s_pid[i] = w->pid[order[i]];
+        s_burst[i] = w->initial_burst[order[i]];
+        order[i] = i;
+    }
+
+    schedFree(w->hot);
+    schedFree(w->pid);
+    schedFree(w->initial_burst);
+    w->hot = s_hot;
+    w->pid = s_pid;
+    w->initial_burst = s_burst;
 }
 
-GANTT* getGanttLJF(PROCESS *process, int n) {
+void storeWorkload(WORKLOAD *w, PROCESS *process) {
     /*
         INTRODUCTION:
-            Simulates Longest Job First (LJF) non-preemptive scheduling.
+            Writes a scheduled workload back into a process array.
 
         INPUT PARAMETERS:
-            - process (PROCESS*): process array.
-            - n (int): number of processes.
+            - w (WORKLOAD*): workload.
+            - process (PROCESS*): process array (n records).
 
         OUTPUT PARAMETERS:
-            - Constructs GANTT chart linked list.
+            - Fills process in the final order of the workload, with wait and turnaround times.
 
         RETURN VALUES:
-            - (GANTT*): pointer to GANTT chart head.
+            - None.
 
         APPROACH:
-            - Sort processes on arrival time, or on burst time in descending order if arrival times are same.
-            - At each step, select longest available job.
-            - Update GANTT chart and stats.
+            - process[i] is built from record order[i], so callers see the processes in the same
+              order (sorted / dispatch order) as when the algorithms reordered the PROCESS array itself.
     */
-    
-    if(n < 1 || !process) {
-        printf("\nInvalid number of Processes!\n");
-        return NULL;
-    }
 
-    if(process) {
-        for(int i = 0; i < n-1; i++)                // sort according to arrival time
-        {
-            for(int j = i+1; j < n; j++)
-            {
-                if(process[i].arrive_time > process[j].arrive_time)
-                {
-                    PROCESS t = process[i];
-                    process[i] = process[j];
-                    process[j] = t;
-                    continue;
-                }
-                if(process[i].arrive_time == process[j].arrive_time) {          // if same arrival time, sort on burst time descending
-                    if(process[i].burst_time < process[j].burst_time) {
-                        PROCESS t = process[i];
-                        process[i] = process[j];
-                        process[j] = t;
-                    }
-                }
-            }
-        }
-    }
-    else {
-        printf("\nFailed to read the processes!\n");
-        return NULL;
+    for(int i = 0; i < w->n; i++) {
+        int idx = w->order[i];
+        process[i].pid = w->pid[idx];
+        process[i].arrive_time = w->hot[idx].arrive_time;
+        process[i].burst_time = w->hot[idx].burst_time;
+        process[i].priority = w->hot[idx].priority;
+        process[i].initial_burst = w->initial_burst[idx];
+        process[i].turnaround_time = w->out[idx].turnaround_time;
+        process[i].wait_time = w->out[idx].wait_time;
     }
+}
 
-    GANTT *ghead = NULL, *gnew = NULL, *gcurr = NULL;
-
-    if(process[0].arrive_time != 0)
-    {
-        ghead = (GANTT *)malloc(sizeof(GANTT));
-        ghead->pid = -1;                        // -1 for IDLE
-        ghead->start_time = 0;
-        ghead->finish_time = process[0].arrive_time;
-        ghead->next = NULL;
-        gcurr = ghead;
-    }
+void destroyWorkload(WORKLOAD *w) {
+    /*
+        INTRODUCTION:
+            Frees allocated memory of a workload.
 
-    for(int i = 0; i < n; ++i) {
-        int maxi = -1;
+        INPUT PARAMETERS:
+            - w (WORKLOAD*): workload.
 
-        gnew = (GANTT *)malloc(sizeof(GANTT));
+        OUTPUT PARAMETERS:
+            - Frees dynamically allocated memory.
 
-        if(!ghead) {
-            gnew->pid = process[i].pid;
-            gnew->start_time = 0;
-            gnew->finish_time = process[i].burst_time;
-            gnew->next = NULL;
-            ghead = gcurr = gnew;
+        RETURN VALUES:
+            - None.
 
-            process[i].wait_time = 0;
-            process[i].turnaround_time = gcurr->finish_time - process[i].arrive_time;
-        }
-        else {
-            if(process[i].arrive_time <= gcurr->finish_time) {
-                int j = i+1;
-                maxi = i;
+        APPROACH:
+            - Use schedFree() on every array, then on the structure.
+    */
 
-                while(j < n && process[j].arrive_time <= gcurr->finish_time) j++;
+    if(!w) return;
+    schedFree(w->hot);
+    schedFree(w->out);
+    schedFree(w->pid);
+    schedFree(w->initial_burst);
+    schedFree(w->order);
+    schedFree(w);
+}
 
-                for(int k = i+1; k < j; ++k) {
-                    if(process[k].burst_time > process[maxi].burst_time) {maxi = k;}
-                }
-                if(maxi != i) {
-                    PROCESS temp = process[maxi];
-                    for (int k = maxi; k > i; --k) {
-                        process[k] = process[k - 1];
-                    }
-                    process[i] = temp;
-                }
+GANTT* ganttAlloc() {
+    // Allocates a GANTT chart entry with schedAlloc
+    STATS_ADD(gantt_allocated, 1);
+    return (GANTT *)schedAlloc(sizeof(GANTT));
+}
 
-                gnew->pid = process[i].pid;
-                gnew->start_time = gcurr->finish_time;
-                gnew->finish_time = gnew->start_time + process[i].burst_time;
-                gnew->next = NULL;
-                gcurr->next = gnew;
-                gcurr = gnew;
+void sinkInit(GANTT_SINK *sink, GANTT_RLE *rle, int merge) {
+    // Starts an empty output, a GANTT_RLE if rle is given, otherwise a linked list
+    sink->ghead = sink->gcurr = NULL;
+    sink->rle = rle;
+    sink->merge = merge;
+    sink->buffer = NULL;
+    sink->discard = 0;
+    sink->has_pending = 0;
+    sink->dispatches = sink->idle = 0;
+    sink->busy = sink->last = 0;
+}
 
-                process[i].wait_time = gcurr->start_time - process[i].arrive_time;
-                process[i].turnaround_time = gcurr->finish_time - process[i].arrive_time;
+void sinkFlush(GANTT_SINK *sink) {
+    // Writes the pending entry
+    if(!sink->has_pending) return;
+    sink->has_pending = 0;
+    if(sink->pending.pid >= 0) {
+        sink->dispatches++;
+        sink->busy += sink->pending.finish_time - sink->pending.start_time;
+    }
+    else if(sink->pending.pid == -1) sink->idle++;
+    sink->last = sink->pending.finish_time;
 
-            }
-            else {
-                gnew->pid = -1;                 // System is IDLE
-                gnew->start_time = gcurr->finish_time;
-                gnew->finish_time = process[i].arrive_time;
-                gnew->next = NULL;
-                gcurr->next = gnew;
-                gcurr = gnew;
-                i--;
-            }
-        }
+    if(sink->discard) return;
+    if(sink->rle) {
+        rleAppend(sink->rle, sink->pending.pid, sink->pending.start_time, sink->pending.finish_time);
+        return;
+    }
+    GANTT *gnew = sink->buffer ? &sink->buffer->data[sink->buffer->used++] : ganttAlloc();
+    *gnew = sink->pending;
+    if(!sink->ghead) sink->ghead = sink->gcurr = gnew;
+    else {
+        sink->gcurr->next = gnew;
+        sink->gcurr = gnew;
     }
-    return ghead;
 }
 
-GANTT* getGanttSRTF(PROCESS *process, int n) {
+void sinkEmit(GANTT_SINK *sink, int pid, SCHED_TIME start_time, SCHED_TIME finish_time) {
     /*
         INTRODUCTION:
-            Simulates Shortest Remaining Time First (SRTF) preemptive scheduling.
+            Adds an entry to the output of a scheduler.
 
         INPUT PARAMETERS:
-            - process (PROCESS*): process array.
-            - n (int): number of processes.
+            - sink (GANTT_SINK*): output.
+            - pid (int): process ID (-1 for IDLE).
+            - start_time, finish_time (SCHED_TIME): time slot of the entry.
 
         OUTPUT PARAMETERS:
-            - Constructs GANTT chart linked list.
+            - Extends the pending entry, or writes it and makes this entry pending.
 
         RETURN VALUES:
-            - (GANTT*): pointer to GANTT chart head.
-
+            - None.
+    */
+
+    if(sink->has_pending && sink->pending.pid == pid && (pid == -1 || sink->merge)) {
+        sink->pending.finish_time = finish_time;
+        STATS_ADD(gantt_merged, 1);
+        return;
+    }
+    sinkFlush(sink);
+    sink->pending.pid = pid;
+    sink->pending.start_time = start_time;
+    sink->pending.finish_time = finish_time;
+    sink->pending.next = NULL;
+    sink->has_pending = 1;
+}
+
+GANTT* sinkClose(GANTT_SINK *sink) {
+    // Writes the pending entry, returns the linked list head (NULL for a GANTT_RLE)
+    sinkFlush(sink);
+    return sink->ghead;
+}
+
+#ifdef SCHED_STATS
+void statsRecordRun(GANTT *ghead, GANTT_SINK *sink, int n, struct timespec *start, struct timespec *sorted) {
+    /*
+        INTRODUCTION:
+            Adds one finished getGantt* call to the counters of the calling thread.
+
+        INPUT PARAMETERS:
+            - ghead (GANTT*): GANTT chart of the run.
+            - sink (GANTT_SINK*): output of the run if it used one (ghead is then ignored), else NULL.
+            - n (int): number of processes.
+            - start, sorted (struct timespec*): times at the start of the call and after sorting.
+
         APPROACH:
-            - Sort processes on arrival time, or on burst time if arrival times are same.
-            - At each time unit, run process with shortest remaining time.
-            - Preempt if necessary.
-            - Update GANTT chart and process stats.
+            - Dispatches and IDLE segments are counted from the finished chart (or by the sink), every
+              dispatch except the last one of each process is a preemption.
+    */
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    schedCounters.sort_ms += (sorted->tv_sec - start->tv_sec)*1e3 + (sorted->tv_nsec - start->tv_nsec)/1e6;
+    schedCounters.simulate_ms += (now.tv_sec - sorted->tv_sec)*1e3 + (now.tv_nsec - sorted->tv_nsec)/1e6;
+
+    long long dispatches = 0;
+    if(sink) {
+        dispatches = sink->dispatches;
+        schedCounters.idle_segments += sink->idle;
+    }
+    for(GANTT *gcurr = sink ? NULL : ghead; gcurr; gcurr = gcurr->next) {
+        if(gcurr->pid >= 0) dispatches++;
+        else if(gcurr->pid == -1) schedCounters.idle_segments++;
+    }
+    schedCounters.runs++;
+    schedCounters.dispatches += dispatches;
+    schedCounters.preemptions += dispatches - n;
+}
+#endif
+
+void schedStatsFlush() {
+    // Adds the counters of the calling thread to the total and clears them
+#ifdef SCHED_STATS
+    pthread_mutex_lock(&schedCountersLock);
+    schedCountersTotal.runs += schedCounters.runs;
+    schedCountersTotal.dispatches += schedCounters.dispatches;
+    schedCountersTotal.preemptions += schedCounters.preemptions;
+    schedCountersTotal.comparisons += schedCounters.comparisons;
+    schedCountersTotal.gantt_allocated += schedCounters.gantt_allocated;
+    schedCountersTotal.gantt_merged += schedCounters.gantt_merged;
+    schedCountersTotal.idle_segments += schedCounters.idle_segments;
+    schedCountersTotal.sort_ms += schedCounters.sort_ms;
+    schedCountersTotal.simulate_ms += schedCounters.simulate_ms;
+    pthread_mutex_unlock(&schedCountersLock);
+    memset(&schedCounters, 0, sizeof(SCHED_COUNTERS));
+#endif
+}
+
+void getSchedStats(SCHED_COUNTERS *stats) {
+    /*
+        INTRODUCTION:
+            Reads the instrumentation counters.
+
+        INPUT PARAMETERS:
+            - stats (SCHED_COUNTERS*): where to store the counters.
+
+        OUTPUT PARAMETERS:
+            - Flushes the counters of the calling thread, then copies the total of all threads
+              (thread pool workers flush after every job). All zero without -DSCHED_STATS.
+
+        RETURN VALUES:
+            - None.
+    */
+
+    memset(stats, 0, sizeof(SCHED_COUNTERS));
+#ifdef SCHED_STATS
+    schedStatsFlush();
+    pthread_mutex_lock(&schedCountersLock);
+    *stats = schedCountersTotal;
+    pthread_mutex_unlock(&schedCountersLock);
+#endif
+}
+
+void resetSchedStats() {
+    // Clears the total and the counters of the calling thread
+#ifdef SCHED_STATS
+    pthread_mutex_lock(&schedCountersLock);
+    memset(&schedCountersTotal, 0, sizeof(SCHED_COUNTERS));
+    pthread_mutex_unlock(&schedCountersLock);
+    memset(&schedCounters, 0, sizeof(SCHED_COUNTERS));
+#endif
+}
+
+void displaySchedStats() {
+    /*
+        INTRODUCTION:
+            Displays the instrumentation counters of all threads.
+
+        APPROACH:
+            - Print every counter, the averages per run and the share of emitted GANTT entries that were merged.
+    */
+
+    SCHED_COUNTERS c;
+    getSchedStats(&c);
+
+    printf("\n\nInstrumentation counters:-");
+#ifndef SCHED_STATS
+    printf("\n(compile with -DSCHED_STATS to enable them)");
+#endif
+    printf("\nRuns: %lld", c.runs);
+    printf("\nDispatches: %lld", c.dispatches);
+    printf("\nPreemptions: %lld", c.preemptions);
+    printf("\nComparisons: %lld", c.comparisons);
+    long long entries = c.gantt_allocated + c.gantt_merged;       // every entry emitted, added or merged
+    printf("\nGANTT entries allocated: %lld, merged: %lld (%.1f%%)", c.gantt_allocated, c.gantt_merged,
+        entries ? 100.0*c.gantt_merged/entries : 0.0);
+    printf("\nIDLE segments: %lld", c.idle_segments);
+    printf("\nSort: %.3f ms, simulate: %.3f ms", c.sort_ms, c.simulate_ms);
+    printf("\n----------------------------------------------------------------\n");
+}
+
+int selectMinBurst(PROCESS_HOT *hot, int *order, int first, int last) {
+    /*
+        INTRODUCTION:
+            Finds the shortest job of the ready window of SJF.
+
+        INPUT PARAMETERS:
+            - hot (PROCESS_HOT*): hot fields of the processes.
+            - order (int*): indices of the processes in dispatch order.
+            - first, last (int): ready window order[first] ... order[last-1] (first < last).
+
+        RETURN VALUES:
+            - (int): position in order of the shortest burst, the first one on ties.
+    */
+
+    int mini = first;
+    STATS_ADD(comparisons, last-first-1);
+    for(int k = first+1; k < last; ++k) {
+        if(hot[order[k]].burst_time < hot[order[mini]].burst_time) {mini = k;}
+    }
+    return mini;
+}
+
+int selectMaxBurst(PROCESS_HOT *hot, int *order, int first, int last) {
+    /*
+        INTRODUCTION:
+            Finds the longest job of the ready window of LJF.
+
+        INPUT PARAMETERS:
+            - hot (PROCESS_HOT*): hot fields of the processes.
+            - order (int*): indices of the processes in dispatch order.
+            - first, last (int): ready window order[first] ... order[last-1] (first < last).
+
+        RETURN VALUES:
+            - (int): position in order of the longest burst, the first one on ties.
+    */
+
+    int maxi = first;
+    STATS_ADD(comparisons, last-first-1);
+    for(int k = first+1; k < last; ++k) {
+        if(hot[order[k]].burst_time > hot[order[maxi]].burst_time) {maxi = k;}
+    }
+    return maxi;
+}
+
+int selectMaxResponseRatio(PROCESS_HOT *hot, int *order, int first, int last, SCHED_TIME now) {
+    /*
+        INTRODUCTION:
+            Finds the process with the highest response ratio of the ready window of HRRN.
+
+        INPUT PARAMETERS:
+            - hot (PROCESS_HOT*): hot fields of the processes.
+            - order (int*): indices of the processes in dispatch order.
+            - first, last (int): ready window order[first] ... order[last-1] (first < last).
+            - now (SCHED_TIME): current time.
+
+        RETURN VALUES:
+            - (int): position in order of the highest ratio 1 + wait / burst, the first one on ties.
+    */
+
+    int mini = first;
+    float max_hrrn = -1.0;
+    STATS_ADD(comparisons, last-first);
+    for(int k = first; k < last; ++k) {
+        float wait = (float)(now - hot[order[k]].arrive_time);
+        float hrrn = 1+ (float)(wait / hot[order[k]].burst_time);
+        if(hrrn > max_hrrn) {
+            mini = k;
+            max_hrrn = hrrn;
+        }
+    }
+    return mini;
+}
+
+int selectShortestRemaining(PROCESS_HOT *hot, int count) {
+    /*
+        INTRODUCTION:
+            Finds the arrived process with the shortest remaining time for SRTF.
+
+        INPUT PARAMETERS:
+            - hot (PROCESS_HOT*): hot fields sorted by arrival time, burst_time is the remaining time.
+            - count (int): number of arrived processes (hot[0] ... hot[count-1]).
+
+        RETURN VALUES:
+            - (int): index of the shortest unfinished process, the first one on ties, -1 if none.
+    */
+
+    int min_idx = -1;
+    SCHED_TIME min_burst = TIME_MAX;
+    STATS_ADD(comparisons, count);
+    for (int i = 0; i < count; i++) {
+        if (hot[i].burst_time > 0 && hot[i].burst_time < min_burst) {
+            min_burst = hot[i].burst_time;
+            min_idx = i;
+        }
+    }
+    return min_idx;
+}
+
+int selectLongestRemaining(PROCESS_HOT *hot, int count, int *runner_up) {
+    /*
+        INTRODUCTION:
+            Finds the arrived process with the longest remaining time for LRTF, and the runner-up.
+
+        INPUT PARAMETERS:
+            - hot (PROCESS_HOT*): hot fields sorted by arrival time, burst_time is the remaining time.
+            - count (int): number of arrived processes (hot[0] ... hot[count-1]).
+
+        OUTPUT PARAMETERS:
+            - runner_up (int*): the process that takes over (-1 if none): the longest of the others,
+              the second one if the longest time is tied.
+
+        RETURN VALUES:
+            - (int): index of the longest unfinished process, the first one on ties, -1 if none.
+    */
+
+    int max_idx = -1, next_idx = -1;
+    SCHED_TIME max_burst = -1;
+    STATS_ADD(comparisons, count);
+    for (int i = 0; i < count; i++) {
+        if (hot[i].burst_time > 0) {
+            if (hot[i].burst_time > max_burst) {
+                next_idx = max_idx;
+                max_burst = hot[i].burst_time;
+                max_idx = i;
+            }
+            else if (next_idx == -1 || hot[i].burst_time > hot[next_idx].burst_time) {
+                next_idx = i;
+            }
+        }
+    }
+    *runner_up = next_idx;
+    return max_idx;
+}
+
+void admitArrivals(PROCESS_HOT *hot, int n, SCHED_TIME now, int *admitted, int *queue, int *rear, int *q_size) {
+    /*
+        INTRODUCTION:
+            Moves the processes that have arrived into the circular ready queue of Round Robin.
+
+        INPUT PARAMETERS:
+            - hot (PROCESS_HOT*): hot fields sorted by arrival time.
+            - n (int): number of processes, also the capacity of queue.
+            - now (SCHED_TIME): current time.
+            - admitted (int*): processes before this index have already been admitted.
+            - queue (int*), rear (int*), q_size (int*): circular queue.
+
+        OUTPUT PARAMETERS:
+            - Appends the new arrivals to queue in arrival order, advances *admitted.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Processes arrive in array order, so only the processes from *admitted on have to be checked:
+              O(1) per admitted process instead of a scan of all processes at every dispatch.
+            - Processes with a zero burst are skipped, they never enter the queue.
+    */
+
+    while(*admitted < n && hot[*admitted].arrive_time <= now) {
+        int i = (*admitted)++;
+        if(hot[i].burst_time > 0) {
+            *rear = (*rear+1)%n;
+            queue[*rear] = i;
+            (*q_size)++;
+        }
+    }
+}
+
+#define SCHED_INLINE static inline __attribute__((always_inline))
+
+SCHED_INLINE GANTT* schedSimulate(const SCHED_POLICY policy, PROCESS *process, int n, SCHED_TIME time_slice, GANTT_SINK *sink) {
+    /*
+        INTRODUCTION:
+            Simulation core shared by all nine scheduling algorithms.
+
+        INPUT PARAMETERS:
+            - policy (SCHED_POLICY): algorithm, a constant at every call site (see SCHED_SIMULATOR).
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+            - time_slice (SCHED_TIME): time quantum, only used by Round Robin.
+            - sink (GANTT_SINK*): initialized output, a linked list or a GANTT_RLE.
+
+        OUTPUT PARAMETERS:
+            - Fills the wait and turnaround times of process. The non-preemptive algorithms write the
+              processes back in the order they ran, the others in arrival order.
+
+        RETURN VALUES:
+            - (GANTT*): pointer to GANTT chart head if the sink builds a linked list, else NULL.
+
+        APPROACH:
+            - Sort processes on arrival time, or on the key of the algorithm if arrival times are same.
+            - Every iteration admits the arrived processes, selects one and runs it for one step:
+                - non-preemptive: until it completes;
+                - SRTF, Priority (preemptive): until it completes or the next process arrives;
+                - LRTF: also until the runner-up overtakes it, processes tied at the longest remaining
+                  time alternate every unit and their rounds are computed at once;
+                - Round Robin: for one time slice.
+            - If nothing is ready the system is IDLE until the next arrival.
+            - The function is always inlined with a constant policy, so the compiler drops the
+              branches of the other algorithms and each one gets its own loop.
     */
 
+    const int preemptive = (policy == POLICY_SRTF || policy == POLICY_PRIORITY_PREEMPTIVE ||
+                            policy == POLICY_LRTF || policy == POLICY_ROUND_ROBIN);
+    const int queued = (policy == POLICY_PRIORITY || policy == POLICY_PRIORITY_PREEMPTIVE);
+
     if(n < 1 || !process) {
         printf("\nInvalid number of Processes!\n");
         return NULL;
     }
 
-    if(process) {
-        for(int i = 0; i < n-1; i++)                // sort according to arrival time
-        {
-            for(int j = i+1; j < n; j++)
-            {
-                if(process[i].arrive_time > process[j].arrive_time)
-                {
-                    PROCESS t = process[i];
-                    process[i] = process[j];
-                    process[j] = t;
-                    continue;
-                }
-                if(process[i].arrive_time == process[j].arrive_time) {          // if same arrival time, sort on burst time
-                    if(process[i].burst_time > process[j].burst_time) {
-                        PROCESS t = process[i];
-                        process[i] = process[j];
-                        process[j] = t;
-                    }
+    if(policy == POLICY_ROUND_ROBIN && time_slice <= 0) {
+        printf("\nInvalid value of Time Slice!\n");
+        return NULL;
+    }
+
+    STATS_CLOCK(stats_start);
+    WORKLOAD *w = getWorkload(process, n);
+    sortWorkload(w, policySortKeys[policy]);
+    STATS_CLOCK(stats_sorted);
+    PROCESS_HOT *hot = w->hot;
+    PROCESS_OUT *out = w->out;
+    int *order = w->order;
+
+    RUNQUEUE rq;                                    // ready processes of the Priority algorithms
+    if(queued) runqInit(&rq, hot, n);
+    int *queue = NULL, front = 0, rear = -1, q_size = 0;     // circular ready queue of Round Robin
+    if(policy == POLICY_ROUND_ROBIN) queue = (int *)schedAlloc(n*sizeof(int));
+    int *group = NULL;                              // LRTF tie group
+    if(policy == POLICY_LRTF) group = (int *)schedAlloc(n*sizeof(int));
+
+    int completed = 0, arrived = 0, dispatched = 0;
+    SCHED_TIME curr_time = 0, step;
+
+    while(completed < n) {
+        if(policy == POLICY_ROUND_ROBIN) admitArrivals(hot, n, curr_time, &arrived, queue, &rear, &q_size);
+        else {
+            while(arrived < n && hot[arrived].arrive_time <= curr_time) {
+                if(queued) runqPush(&rq, arrived);
+                arrived++;
+            }
+        }
+
+        int idx = -1, next_idx = -1;
+        if(!preemptive && !queued) {                // ready window order[dispatched] ... order[arrived-1]
+            if(dispatched < arrived) {
+                int k = dispatched;
+                if(policy == POLICY_SJF) k = selectMinBurst(hot, order, dispatched, arrived);
+                if(policy == POLICY_HRRN) k = selectMaxResponseRatio(hot, order, dispatched, arrived, curr_time);
+                if(policy == POLICY_LJF) k = selectMaxBurst(hot, order, dispatched, arrived);
+
+                idx = order[k];
+                for(; k > dispatched; k--) order[k] = order[k-1];  // the others stay in arrival order
+                order[dispatched++] = idx;
+            }
+        }
+        else if(policy == POLICY_PRIORITY) {
+            idx = runqPop(&rq);
+            if(idx != -1) order[dispatched++] = idx;
+        }
+        else if(policy == POLICY_PRIORITY_PREEMPTIVE) idx = runqPeek(&rq);     // stays queued until it completes
+        else if(policy == POLICY_SRTF) idx = selectShortestRemaining(hot, arrived);
+        else if(policy == POLICY_LRTF) idx = selectLongestRemaining(hot, arrived, &next_idx);
+        else if(q_size > 0) {
+            idx = queue[front];
+            front = (front+1)%n;
+            q_size--;
+        }
+
+        if(idx == -1) {                             // system is IDLE until the next arrival
+            sinkEmit(sink, -1, curr_time, hot[arrived].arrive_time);
+            curr_time = hot[arrived].arrive_time;
+            continue;
+        }
+
+        if(policy == POLICY_LRTF && next_idx != -1 && hot[next_idx].burst_time == hot[idx].burst_time) {
+            /*
+                Tie group: every round, the processes at the longest remaining time run 1 unit each
+                in array order. Run whole rounds until the group reaches the longest remaining time
+                of the others (they join it) or the next process arrives, without scanning again.
+            */
+            int k = 0;
+            SCHED_TIME below = 0;                   // longest remaining time outside the group
+            for (int i = 0; i < arrived; i++) {
+                if (hot[i].burst_time == hot[idx].burst_time) group[k++] = i;
+                else if (hot[i].burst_time > below) below = hot[i].burst_time;
+            }
+
+            SCHED_TIME rounds = hot[idx].burst_time - below, ticks = rounds * k;
+            if(arrived < n && hot[arrived].arrive_time - curr_time < ticks) ticks = hot[arrived].arrive_time - curr_time;
+
+            for (int g = 0; ticks > 0; ticks--) {
+                int i = group[g];
+                sinkEmit(sink, w->pid[i], curr_time, curr_time + 1);
+                curr_time++;
+                if (--hot[i].burst_time == 0) {
+                    completed++;
+                    out[i].turnaround_time = curr_time - hot[i].arrive_time;
+                    out[i].wait_time = out[i].turnaround_time - w->initial_burst[i];
                 }
+                if (++g == k) g = 0;
+            }
+            continue;
+        }
+
+        step = hot[idx].burst_time;
+        if(policy == POLICY_ROUND_ROBIN) {
+            if(time_slice < step) step = time_slice;
+        }
+        else if(preemptive) {                       // nothing changes before completion, takeover or the next arrival
+            if(policy == POLICY_LRTF && next_idx != -1) {   // runner-up wins ties only when it comes first in the array
+                SCHED_TIME takeover = hot[idx].burst_time - hot[next_idx].burst_time + (idx < next_idx ? 1 : 0);
+                if(takeover < step) step = takeover;
+            }
+            if(arrived < n && hot[arrived].arrive_time - curr_time < step) step = hot[arrived].arrive_time - curr_time;
+        }
+
+        sinkEmit(sink, w->pid[idx], curr_time, curr_time + step);
+        curr_time += step;
+
+        if(!preemptive) {
+            completed++;
+            out[idx].wait_time = curr_time - step - hot[idx].arrive_time;
+            out[idx].turnaround_time = curr_time - hot[idx].arrive_time;
+            continue;
+        }
+
+        hot[idx].burst_time -= step;
+        if(policy == POLICY_ROUND_ROBIN) {          // arrivals during the slice queue up before it
+            admitArrivals(hot, n, curr_time, &arrived, queue, &rear, &q_size);
+            if(hot[idx].burst_time > 0) {
+                rear = (rear+1)%n;
+                queue[rear] = idx;
+                q_size++;
             }
         }
+
+        if(hot[idx].burst_time == 0) {
+            completed++;
+            if(policy == POLICY_PRIORITY_PREEMPTIVE) runqPop(&rq);
+            out[idx].turnaround_time = curr_time - hot[idx].arrive_time;
+            out[idx].wait_time = out[idx].turnaround_time - w->initial_burst[idx];
+        }
     }
-    else {
-        printf("\nFailed to read the processes!\n");
-        return NULL;
+
+    if(queued) runqDestroy(&rq);
+    schedFree(queue);
+    schedFree(group);
+    GANTT *ghead = sinkClose(sink);
+    STATS_SINK(sink, n, stats_start, stats_sorted);
+    storeWorkload(w, process);
+    destroyWorkload(w);
+    return ghead;
+}
+
+// One specialized copy of the simulation core per algorithm
+#define SCHED_SIMULATOR(name, policy) \
+    GANTT* name(PROCESS *process, int n, SCHED_TIME time_slice, GANTT_SINK *sink) { \
+        return schedSimulate(policy, process, n, time_slice, sink); \
+    }
+
+SCHED_SIMULATOR(simulateFCFS, POLICY_FCFS)
+SCHED_SIMULATOR(simulateSJF, POLICY_SJF)
+SCHED_SIMULATOR(simulateHRRN, POLICY_HRRN)
+SCHED_SIMULATOR(simulatePriority, POLICY_PRIORITY)
+SCHED_SIMULATOR(simulateLJF, POLICY_LJF)
+SCHED_SIMULATOR(simulateSRTF, POLICY_SRTF)
+SCHED_SIMULATOR(simulatePriorityPreemptive, POLICY_PRIORITY_PREEMPTIVE)
+SCHED_SIMULATOR(simulateLRTF, POLICY_LRTF)
+SCHED_SIMULATOR(simulateRoundRobin, POLICY_ROUND_ROBIN)
+
+GANTT* (*const policySimulators[POLICY_COUNT])(PROCESS *, int, SCHED_TIME, GANTT_SINK *) = {
+    simulateFCFS, simulateSJF, simulateHRRN, simulatePriority, simulateLJF,
+    simulateSRTF, simulatePriorityPreemptive, simulateLRTF, simulateRoundRobin
+};
+
+GANTT* getGanttFCFS(PROCESS *process, int n) {
+    /*
+        INTRODUCTION:
+            Simulates First-Come First-Serve (FCFS) scheduling.
+
+        INPUT PARAMETERS:
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+
+        OUTPUT PARAMETERS:
+            - Constructs GANTT chart linked list.
+
+        RETURN VALUES:
+            - (GANTT*): pointer to GANTT chart head.
+
+        APPROACH:
+            - Sort processes by arrival time.
+            - Execute processes in order, updating GANTT linked list.
+    */
+
+    GANTT_SINK sink;
+    sinkInit(&sink, NULL, 0);
+    return simulateFCFS(process, n, 0, &sink);
+}
+
+GANTT* getGanttSJF(PROCESS *process, int n) {
+    /*
+        INTRODUCTION:
+            Simulates Shortest Job First (SJF) non-preemptive scheduling.
+
+        INPUT PARAMETERS:
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+
+        OUTPUT PARAMETERS:
+            - Constructs GANTT chart linked list.
+
+        RETURN VALUES:
+            - (GANTT*): pointer to GANTT chart head.
+
+        APPROACH:
+            - Sort processes by arrival time, or on burst time if arrival times are same.
+            - Select shortest available job at each time point.
+            - Update GANTT chart and process stats.
+    */
+
+    GANTT_SINK sink;
+    sinkInit(&sink, NULL, 0);
+    return simulateSJF(process, n, 0, &sink);
+}
+
+GANTT* getGanttHRRN(PROCESS *process, int n) {
+    /*
+        INTRODUCTION:
+            Simulates Highest Response Ratio Next (HRRN) scheduling.
+
+        INPUT PARAMETERS:
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+
+        OUTPUT PARAMETERS:
+            - Constructs GANTT chart linked list.
+
+        RETURN VALUES:
+            - (GANTT*): pointer to GANTT chart head.
+
+        APPROACH:
+            - Sort processes on arrival time, or on burst time if arrival times are same.
+            - At each step, pick process with highest response ratio.
+            - Update GANTT chart and process stats.
+    */
+
+    GANTT_SINK sink;
+    sinkInit(&sink, NULL, 0);
+    return simulateHRRN(process, n, 0, &sink);
+}
+
+GANTT* getGanttPriority(PROCESS *process, int n) {
+    /*
+        INTRODUCTION:
+            Simulates non-preemptive priority scheduling.
+
+        INPUT PARAMETERS:
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+
+        OUTPUT PARAMETERS:
+            - Constructs GANTT chart linked list.
+
+        RETURN VALUES:
+            - (GANTT*): pointer to GANTT chart head.
+
+        APPROACH:
+            - Sort processes on arrival time, or on priority if arrival times are same.
+            - Push arrived processes on a run queue, pick the one with highest priority
+              (the earliest in sorted order among equal priorities) in O(1).
+            - Execute, update GANTT chart.
+    */
+
+    GANTT_SINK sink;
+    sinkInit(&sink, NULL, 0);
+    return simulatePriority(process, n, 0, &sink);
+}
+
+GANTT* getGanttLJF(PROCESS *process, int n) {
+    /*
+        INTRODUCTION:
+            Simulates Longest Job First (LJF) non-preemptive scheduling.
+
+        INPUT PARAMETERS:
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+
+        OUTPUT PARAMETERS:
+            - Constructs GANTT chart linked list.
+
+        RETURN VALUES:
+            - (GANTT*): pointer to GANTT chart head.
+
+        APPROACH:
+            - Sort processes on arrival time, or on burst time in descending order if arrival times are same.
+            - At each step, select longest available job.
+            - Update GANTT chart and stats.
+    */
+
+    GANTT_SINK sink;
+    sinkInit(&sink, NULL, 0);
+    return simulateLJF(process, n, 0, &sink);
+}
+
+GANTT* getGanttSRTF(PROCESS *process, int n) {
+    /*
+        INTRODUCTION:
+            Simulates Shortest Remaining Time First (SRTF) preemptive scheduling.
+
+        INPUT PARAMETERS:
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+
+        OUTPUT PARAMETERS:
+            - Constructs GANTT chart linked list.
+
+        RETURN VALUES:
+            - (GANTT*): pointer to GANTT chart head.
+
+        APPROACH:
+            - Sort processes on arrival time, or on burst time if arrival times are same.
+            - Run the process with shortest remaining time until it completes or the next process arrives.
+            - Preempt if necessary; idle gaps jump straight to the next arrival.
+            - Update GANTT chart and process stats.
+    */
+
+    GANTT_SINK sink;
+    sinkInit(&sink, NULL, 1);
+    return simulateSRTF(process, n, 0, &sink);
+}
+
+GANTT* getGanttPriorityPreemptive(PROCESS *process, int n) {
+    /*
+        INTRODUCTION:
+            Simulates Priority Preemptive scheduling.
+
+        INPUT PARAMETERS:
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+
+        OUTPUT PARAMETERS:
+            - Constructs GANTT chart linked list.
+
+        RETURN VALUES:
+            - (GANTT*): pointer to GANTT chart head.
+
+        APPROACH:
+            - Sort processes on arrival times, or on priority if arrival times are same.
+            - Run the highest-priority (lowest value) process until it completes or the next process arrives,
+              the run queue finds it in O(1).
+            - Preempt if a higher-priority process arrives; idle gaps jump straight to the next arrival.
+            - Update GANTT chart and process stats.
+    */
+
+    GANTT_SINK sink;
+    sinkInit(&sink, NULL, 1);
+    return simulatePriorityPreemptive(process, n, 0, &sink);
+}
+
+GANTT* getGanttLRTF(PROCESS *process, int n) {
+    /*
+        INTRODUCTION:
+            Simulates Longest Remaining Time First (LRTF) preemptive scheduling.
+
+        INPUT PARAMETERS:
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+
+        OUTPUT PARAMETERS:
+            - Constructs GANTT chart linked list.
+
+        RETURN VALUES:
+            - (GANTT*): pointer to GANTT chart head.
+
+        APPROACH:
+            - Sort processes on arrival time, or on burst time in descending order if arrival times are same.
+            - Run the process with longest remaining time until the runner-up overtakes it,
+              it completes or the next process arrives.
+            - Processes tied at the longest remaining time alternate every unit; their rounds are
+              computed at once up to the next arrival or the next lower remaining time.
+            - Preempt if necessary; idle gaps jump straight to the next arrival.
+            - Update GANTT chart and process stats.
+    */
+
+    GANTT_SINK sink;
+    sinkInit(&sink, NULL, 1);
+    return simulateLRTF(process, n, 0, &sink);
+}
+
+GANTT* getGanttRoundRobin(PROCESS *process, int n, SCHED_TIME time_slice) {
+    /*
+        INTRODUCTION:
+            Implements the Round Robin CPU scheduling algorithm.
+
+        INPUT PARAMETERS:
+            - process (PROCESS*): Array of process structure
+            - n (int): Number of processes.
+            - time_slice (SCHED_TIME): The time quantum for the Round Robin scheduling.
+
+        OUTPUT PARAMETERS:
+            - Constructs Gantt chart linked list
+
+        RETURN VALUES:
+            - ghead (GANTT*): Pointer to the head of the GANTT linked list representing the scheduling timeline.
+
+        APPROACH:
+            - Validate number of processes and time_slice.
+            - Sort processes based on their arrival time.
+            - Initialize a circular queue to manage the scheduling order, admit arrivals in arrival order.
+            - Run a loop until all processes are completed:
+            - Update GANTT chart and process stats.
+    */
+
+    GANTT_SINK sink;
+    sinkInit(&sink, NULL, 0);
+    return simulateRoundRobin(process, n, time_slice, &sink);
+}
+
+GANTT* getGanttPolicy(SCHED_POLICY policy, PROCESS *process, int n, SCHED_TIME time_slice) {
+    /*
+        INTRODUCTION:
+            Runs the scheduling algorithm selected by policy.
+
+        INPUT PARAMETERS:
+            - policy (SCHED_POLICY): scheduling algorithm.
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+            - time_slice (SCHED_TIME): time quantum (only used by Round Robin).
+
+        OUTPUT PARAMETERS:
+            - Same as the selected getGantt* function.
+
+        RETURN VALUES:
+            - (GANTT*): pointer to GANTT chart head, NULL if policy is invalid.
+    */
+
+    switch(policy) {
+        case POLICY_FCFS: return getGanttFCFS(process, n);
+        case POLICY_SJF: return getGanttSJF(process, n);
+        case POLICY_HRRN: return getGanttHRRN(process, n);
+        case POLICY_PRIORITY: return getGanttPriority(process, n);
+        case POLICY_LJF: return getGanttLJF(process, n);
+        case POLICY_SRTF: return getGanttSRTF(process, n);
+        case POLICY_PRIORITY_PREEMPTIVE: return getGanttPriorityPreemptive(process, n);
+        case POLICY_LRTF: return getGanttLRTF(process, n);
+        case POLICY_ROUND_ROBIN: return getGanttRoundRobin(process, n, time_slice);
+        default:
+            printf("\nInvalid scheduling policy!\n");
+            return NULL;
+    }
+}
+
+int getStatsPolicy(SCHED_POLICY policy, PROCESS *process, int n, SCHED_TIME time_slice, SCHED_SUMMARY *sum) {
+    /*
+        INTRODUCTION:
+            Runs the scheduling algorithm selected by policy for its statistics only.
+
+        INPUT PARAMETERS:
+            - policy (SCHED_POLICY): scheduling algorithm.
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+            - time_slice (SCHED_TIME): time quantum (only used by Round Robin).
+
+        OUTPUT PARAMETERS:
+            - Fills the wait and turnaround times of process like getGanttPolicy().
+            - sum (SCHED_SUMMARY*): averages, makespan, busy time and number of GANTT chart entries.
+
+        RETURN VALUES:
+            - (int): 0 on success, -1 if any error.
+
+        APPROACH:
+            - Same simulation as getGanttPolicy(), with a sink that only counts the entries it would
+              have written, so no GANTT chart entry is allocated and memory stays O(n).
+    */
+
+    if(policy < 0 || policy >= POLICY_COUNT) {
+        printf("\nInvalid scheduling policy!\n");
+        return -1;
+    }
+
+    GANTT_SINK sink;
+    sinkInit(&sink, NULL, policyMerges[policy]);
+    sink.discard = 1;
+    policySimulators[policy](process, n, time_slice, &sink);
+    if(sink.dispatches == 0) return -1;         // the algorithm rejected its input
+
+    long long waitSum = 0, tatSum = 0;
+    for(int i = 0; i < n; i++) {
+        waitSum += process[i].wait_time;
+        tatSum += process[i].turnaround_time;
+    }
+    sum->avg_wait = (double)waitSum/n;
+    sum->avg_tat = (double)tatSum/n;
+    sum->makespan = sink.last;
+    sum->busy = sink.busy;
+    sum->entries = sink.dispatches + sink.idle;
+    return 0;
+}
+
+void ganttBufferInit(GANTT_BUFFER *buf) {
+    // Initializes an empty buffer, getGanttBuffered() allocates it
+    buf->data = NULL;
+    buf->capacity = buf->used = 0;
+}
+
+GANTT* getGanttBuffered(SCHED_POLICY policy, PROCESS *process, int n, GANTT_BUFFER *buf) {
+    /*
+        INTRODUCTION:
+            Runs a non-preemptive scheduling algorithm with its GANTT chart in a reusable buffer.
+
+        INPUT PARAMETERS:
+            - policy (SCHED_POLICY): FCFS, SJF, HRRN, Priority or LJF.
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+            - buf (GANTT_BUFFER*): buffer from ganttBufferInit(), may hold the chart of an earlier run.
+
+        OUTPUT PARAMETERS:
+            - Fills the wait and turnaround times of process like getGanttPolicy().
+            - Overwrites the entries of buf.
+
+        RETURN VALUES:
+            - (GANTT*): pointer to GANTT chart head (buf->data), NULL if any error. The chart belongs to
+              the buffer: its entries are one block, so they must not be freed or unlinked one by one
+              (no destroyGantt()), and it is valid until the next run with buf. Use ganttCopy() for a
+              chart of its own.
+
+        APPROACH:
+            - Every process is dispatched once and at most one IDLE gap comes before it, so the chart
+              has at most 2n entries: grow buf to that size once, reuse it as long as it is large enough.
+            - The entries are still linked, so every function that reads a GANTT chart accepts the
+              result (applySwitchCost() too, it builds a new chart).
+    */
+
+    if(policy != POLICY_FCFS && policy != POLICY_SJF && policy != POLICY_HRRN &&
+       policy != POLICY_PRIORITY && policy != POLICY_LJF) {
+        printf("\nInvalid scheduling policy!\n");
+        return NULL;
+    }
+    if(n < 1 || !process) {
+        printf("\nInvalid number of Processes!\n");
+        return NULL;
+    }
+
+    if(buf->capacity < 2*n) {
+        free(buf->data);
+        buf->capacity = 2*n;
+        buf->data = (GANTT *)malloc(buf->capacity*sizeof(GANTT));
+    }
+    buf->used = 0;
+
+    GANTT_SINK sink;
+    sinkInit(&sink, NULL, policyMerges[policy]);
+    sink.buffer = buf;
+    return policySimulators[policy](process, n, 0, &sink);
+}
+
+GANTT* ganttCopy(GANTT *ghead) {
+    /*
+        INTRODUCTION:
+            Copies a GANTT chart, e.g. one that belongs to a GANTT_BUFFER.
+
+        INPUT PARAMETERS:
+            - ghead (GANTT*): pointer to GANTT chart head.
+
+        RETURN VALUES:
+            - (GANTT*): head of the copy (entries from ganttAlloc(), freed with destroyGantt()), NULL if ghead is NULL.
+    */
+
+    GANTT *chead = NULL, *ccurr = NULL;
+    for(GANTT *g = ghead; g; g = g->next) {
+        GANTT *gnew = ganttAlloc();
+        *gnew = *g;
+        gnew->next = NULL;
+        if(!chead) chead = ccurr = gnew;
+        else {
+            ccurr->next = gnew;
+            ccurr = gnew;
+        }
+    }
+    return chead;
+}
+
+void ganttBufferDestroy(GANTT_BUFFER *buf) {
+    // Frees the entries of a buffer
+    free(buf->data);
+    ganttBufferInit(buf);
+}
+
+int getCpuTopology(int *cpu, int *node, int max) {
+    /*
+        INTRODUCTION:
+            Lists the CPUs the process may run on, grouped by NUMA node.
+
+        INPUT PARAMETERS:
+            - cpu (int*), node (int*): arrays of length max.
+            - max (int): maximum number of CPUs to list.
+
+        OUTPUT PARAMETERS:
+            - Fills cpu[i] with a CPU number and node[i] with its node, node by node.
+
+        RETURN VALUES:
+            - (int): number of CPUs listed.
+
+        APPROACH:
+            - Read /sys/devices/system/node/node<k>/cpulist ("0-3,8-11") and keep the CPUs of the affinity mask.
+            - Without NUMA information every CPU of the affinity mask is on node 0.
+            - Without the affinity API (no CPU_SETSIZE) the online CPUs are listed on node 0.
+    */
+
+#ifndef CPU_SETSIZE
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    int n = (online > 0 && online < max) ? (int)online : ((online > 0) ? max : 0);
+    for(int x = 0; x < n; x++) {
+        cpu[x] = x;
+        node[x] = 0;
+    }
+    return n;
+#else
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if(sched_getaffinity(0, sizeof(mask), &mask) != 0) return 0;
+
+    int count = 0;
+    for(int k = 0; k < 1024 && count < max; k++) {
+        char path[64];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", k);
+        FILE *fptr = fopen(path, "r");
+        if(!fptr) {
+            if(k > 0) break;
+            continue;
+        }
+
+        int lo, hi;
+        while(fscanf(fptr, "%d", &lo) == 1) {
+            hi = lo;
+            int c = fgetc(fptr);
+            if(c == '-') {
+                if(fscanf(fptr, "%d", &hi) != 1) break;
+                c = fgetc(fptr);
+            }
+            for(int x = lo; x <= hi && count < max; x++) {
+                if(x < CPU_SETSIZE && CPU_ISSET(x, &mask)) {
+                    cpu[count] = x;
+                    node[count++] = k;
+                }
+            }
+            if(c != ',') break;
+        }
+        fclose(fptr);
+    }
+
+    if(count == 0) {
+        for(int x = 0; x < CPU_SETSIZE && count < max; x++) {
+            if(CPU_ISSET(x, &mask)) {
+                cpu[count] = x;
+                node[count++] = 0;
+            }
+        }
+    }
+    return count;
+#endif
+}
+
+void workerPush(WORKER *w, JOB *job) {
+    // Adds a job at the bottom of the deque of w, doubling the deque when it is full
+    pthread_mutex_lock(&w->lock);
+    if(w->size == w->capacity) {
+        JOB **jobs = (JOB **)malloc(2*w->capacity*sizeof(JOB *));
+        for(int k = 0; k < w->size; k++) jobs[k] = w->jobs[(w->top+k)%w->capacity];
+        free(w->jobs);
+        w->jobs = jobs;
+        w->top = 0;
+        w->capacity *= 2;
+    }
+    w->jobs[(w->top + w->size++)%w->capacity] = job;
+    pthread_mutex_unlock(&w->lock);
+}
+
+JOB* workerTake(WORKER *w, int steal) {
+    // Removes the bottom job (owner) or the top job (thief) of the deque of w, NULL if empty
+    JOB *job = NULL;
+    pthread_mutex_lock(&w->lock);
+    if(w->size > 0) {
+        if(steal) {
+            job = w->jobs[w->top];
+            w->top = (w->top+1)%w->capacity;
+        }
+        else job = w->jobs[(w->top + w->size-1)%w->capacity];
+        w->size--;
+    }
+    pthread_mutex_unlock(&w->lock);
+    return job;
+}
+
+JOB* workerFind(WORKER *w) {
+    /*
+        INTRODUCTION:
+            Finds the next job of a worker.
+
+        INPUT PARAMETERS:
+            - w (WORKER*): worker looking for a job.
+
+        RETURN VALUES:
+            - (JOB*): job to run, NULL if every deque is empty.
+
+        APPROACH:
+            - Take the most recently pushed job of the own deque (cache-warm, nested submissions).
+            - Otherwise steal the oldest job of another worker, workers on the same NUMA node first.
+    */
+
+    JOB *job = workerTake(w, 0);
+    if(job) return job;
+
+    POOL *pool = w->pool;
+    for(int same = 1; same >= 0; same--) {
+        for(int k = 1; k < pool->n_workers; k++) {
+            WORKER *victim = &pool->worker[(w->id+k)%pool->n_workers];
+            if((victim->node == w->node) != same) continue;
+            if((job = workerTake(victim, 1))) return job;
+        }
+    }
+    return NULL;
+}
+
+void workerRun(WORKER *w, JOB *job) {
+    /*
+        INTRODUCTION:
+            Runs one job on a worker.
+
+        INPUT PARAMETERS:
+            - w (WORKER*): worker running the job.
+            - job (JOB*): job to run.
+
+        OUTPUT PARAMETERS:
+            - Fills job->result and job->gantt from the arena of the worker.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Copy the input processes to the arena and run the algorithm with the arena bound.
+            - Statistics-only jobs build no GANTT chart.
+            - If the job has a finish function, call it. Then, or right away for statistics-only jobs,
+              reset the arena when no kept results are in it; otherwise keep the results until poolRelease.
+    */
+
+    job->result = (PROCESS *)arenaAlloc(&w->arena, job->n*sizeof(PROCESS));
+    memcpy(job->result, job->process, job->n*sizeof(PROCESS));
+    if(job->summary) getStatsPolicy(job->policy, job->result, job->n, job->time_slice, job->summary);
+    else job->gantt = getGanttPolicy(job->policy, job->result, job->n, job->time_slice);
+
+    if(job->finish) job->finish(job);
+    if(job->finish || job->summary) {
+        job->result = NULL;
+        job->gantt = NULL;
+        if(w->held == 0) arenaReset(&w->arena);
+    }
+    else w->held++;
+    schedStatsFlush();
+}
+
+void* workerMain(void *arg) {
+    // Thread function of a worker: run jobs until the pool shuts down
+    WORKER *w = (WORKER *)arg;
+    POOL *pool = w->pool;
+
+    pthread_mutex_lock(&pool->lock);                // wait until createPool has started every thread
+    pthread_mutex_unlock(&pool->lock);
+
+#ifdef CPU_SETSIZE
+    if(w->cpu >= 0) {
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(w->cpu, &mask);
+        pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+    }
+#endif
+    useArena(&w->arena);
+    poolSelf = w;
+
+    while(1) {
+        JOB *job = workerFind(w);
+        if(job) {
+            __sync_fetch_and_sub(&pool->queued, 1);
+            workerRun(w, job);
+            if(__sync_sub_and_fetch(&pool->outstanding, 1) == 0) {
+                pthread_mutex_lock(&pool->lock);
+                pthread_cond_broadcast(&pool->done);
+                pthread_mutex_unlock(&pool->lock);
+            }
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        __sync_fetch_and_add(&pool->sleeping, 1);
+        while(__atomic_load_n(&pool->queued, __ATOMIC_SEQ_CST) == 0 && !pool->shutdown)
+            pthread_cond_wait(&pool->work, &pool->lock);
+        __sync_fetch_and_sub(&pool->sleeping, 1);
+        int stop = pool->shutdown && __atomic_load_n(&pool->queued, __ATOMIC_SEQ_CST) == 0;
+        pthread_mutex_unlock(&pool->lock);
+        if(stop) break;
+    }
+
+    useArena(NULL);
+    poolSelf = NULL;
+    return NULL;
+}
+
+POOL* createPool(int n_workers, int pin) {
+    /*
+        INTRODUCTION:
+            Creates a work-stealing thread pool for scheduling runs.
+
+        INPUT PARAMETERS:
+            - n_workers (int): number of threads (<= 0: one per CPU the process may run on).
+            - pin (int): non-zero to pin every thread to its own CPU.
+
+        OUTPUT PARAMETERS:
+            - Starts the worker threads.
+
+        RETURN VALUES:
+            - (POOL*): pointer to the pool, NULL if no thread could be started.
+
+        APPROACH:
+            - List the CPUs node by node, worker i gets CPU i (modulo the number of CPUs), so consecutive
+              workers share a NUMA node and steal from each other first.
+            - Every worker has its own deque and arena, jobs never go through a shared queue.
+    */
+
+    int max = SCHED_MAX_CPUS;
+    int *cpu = (int *)malloc(max*sizeof(int));
+    int *node = (int *)malloc(max*sizeof(int));
+    int n_cpu = getCpuTopology(cpu, node, max);
+    if(n_workers <= 0) n_workers = (n_cpu > 0) ? n_cpu : 1;
+
+    POOL *pool = (POOL *)calloc(1, sizeof(POOL));
+    pool->worker = (WORKER *)calloc(n_workers, sizeof(WORKER));
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    for(int i = 0; i < n_workers; i++) {
+        WORKER *w = &pool->worker[i];
+        w->pool = pool;
+        w->id = i;
+        w->cpu = (pin && n_cpu > 0) ? cpu[i % n_cpu] : -1;
+        w->node = (n_cpu > 0) ? node[i % n_cpu] : 0;
+        w->capacity = 64;
+        w->jobs = (JOB **)malloc(w->capacity*sizeof(JOB *));
+        pthread_mutex_init(&w->lock, NULL);
+        arenaInit(&w->arena, 64*1024);
+    }
+    free(cpu);
+    free(node);
+
+    pthread_mutex_lock(&pool->lock);
+    for(int i = 0; i < n_workers; i++) {
+        if(pthread_create(&pool->worker[i].thread, NULL, workerMain, &pool->worker[i]) != 0) {
+            if(i == 0) {
+                printf("\nFailed to start the thread pool!\n");
+                pthread_mutex_unlock(&pool->lock);
+                for(int k = 0; k < n_workers; k++) {
+                    arenaDestroy(&pool->worker[k].arena);
+                    free(pool->worker[k].jobs);
+                }
+                free(pool->worker);
+                free(pool);
+                return NULL;
+            }
+            for(int k = i; k < n_workers; k++) {
+                arenaDestroy(&pool->worker[k].arena);
+                free(pool->worker[k].jobs);
+            }
+            break;
+        }
+        pool->n_workers = i+1;
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return pool;
+}
+
+void poolSubmit(POOL *pool, JOB *job) {
+    /*
+        INTRODUCTION:
+            Submits a job to a thread pool.
+
+        INPUT PARAMETERS:
+            - pool (POOL*): thread pool.
+            - job (JOB*): job to run, must stay valid until it has finished.
+
+        OUTPUT PARAMETERS:
+            - Queues job.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - From a worker of the pool, push on its own deque; from any other thread, push on the
+              workers' deques in turn.
+            - Wake a sleeping worker only if there is one.
+    */
+
+    WORKER *w = poolSelf;
+    if(!w || w->pool != pool) w = &pool->worker[__sync_fetch_and_add(&pool->next, 1) % pool->n_workers];
+
+    __sync_fetch_and_add(&pool->outstanding, 1);
+    workerPush(w, job);
+    __sync_fetch_and_add(&pool->queued, 1);
+
+    if(__atomic_load_n(&pool->sleeping, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_signal(&pool->work);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+void poolWait(POOL *pool) {
+    // Blocks until every submitted job has finished (must not be called from a worker)
+    pthread_mutex_lock(&pool->lock);
+    while(__atomic_load_n(&pool->outstanding, __ATOMIC_SEQ_CST) > 0)
+        pthread_cond_wait(&pool->done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void poolRelease(POOL *pool) {
+    // Frees the results kept by finished jobs (after poolWait): resets the arena of every worker
+    for(int i = 0; i < pool->n_workers; i++) {
+        arenaReset(&pool->worker[i].arena);
+        pool->worker[i].held = 0;
+    }
+}
+
+void destroyPool(POOL *pool) {
+    /*
+        INTRODUCTION:
+            Stops a thread pool and frees its memory.
+
+        INPUT PARAMETERS:
+            - pool (POOL*): thread pool.
+
+        OUTPUT PARAMETERS:
+            - Runs the queued jobs, joins the threads and frees the arenas (and the results kept in them).
+
+        RETURN VALUES:
+            - None.
+    */
+
+    if(!pool) return;
+
+    poolWait(pool);
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->work);
+    pthread_mutex_unlock(&pool->lock);
+
+    for(int i = 0; i < pool->n_workers; i++) {
+        WORKER *w = &pool->worker[i];
+        pthread_join(w->thread, NULL);
+        arenaDestroy(&w->arena);
+        pthread_mutex_destroy(&w->lock);
+        free(w->jobs);
+    }
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->work);
+    pthread_cond_destroy(&pool->done);
+    free(pool->worker);
+    free(pool);
+}
+
+int getProcessesFileIO(char *fileName, IO_PROCESS **process) {
+    /*
+        INTRODUCTION:
+            Reads processes with alternating CPU and I/O bursts from a file.
+
+        INPUT PARAMETERS:
+            - fileName (char*): path to file.
+            - process (IO_PROCESS**): pointer to array of IO_PROCESS structs (to be allocated).
+
+        OUTPUT PARAMETERS:
+            - Allocates and fills *process with process data and bursts.
+
+        RETURN VALUES:
+            - (int): number of processes read from file.
+
+        APPROACH:
+            - Open file.
+            - Read number of processes (n) and validate it.
+            - For every process read arrival time, priority, number of bursts and the bursts,
+              the number of bursts must be odd (the process starts and ends on the CPU)
+              and every burst must be positive.
+            - Close file.
+            - Return number of processes, return -1 if any error.
+    */
+
+    FILE *fptr = fopen(fileName, "r");
+    if(!fptr) {
+        printf("\nFailed to open the file!\n");
+        *process = NULL;
+        return -1;
+    }
+
+    int n = 0;
+
+    fscanf(fptr, "%d", &n);
+    if(n < 1) {
+        printf("\nInvalid number of processes!\n");
+        fclose(fptr);
+        *process = NULL;
+        return -1;
+    }
+
+    *process = (IO_PROCESS *)calloc(n, sizeof(IO_PROCESS));
+
+    for(int i = 0; i < n; ++i) {
+        SCHED_TIME check_at = -1;
+        int check_p = -1, check_nb = -1;
+        IO_PROCESS *p = &(*process)[i];
+
+        if(fscanf(fptr, TIME_FMT " %d %d", &check_at, &check_p, &check_nb) != 3) {
+            printf("\nIncomplete data in the file at process %d!\n", i);
+            fclose(fptr);
+            destroyProcessesIO(*process, i);
+            *process = NULL;
+            return -1;
+        }
+        if(check_at < 0 || check_p < 0 || check_nb < 1 || check_nb % 2 == 0) {
+            printf("\nInvalid value for arrival time/priority/number of bursts at process %d!\n", i);
+            fclose(fptr);
+            destroyProcessesIO(*process, i);
+            *process = NULL;
+            return -1;
+        }
+
+        p->pid = i;
+        p->arrive_time = check_at;
+        p->priority = check_p;
+        p->n_bursts = check_nb;
+        p->bursts = (SCHED_TIME *)malloc(check_nb*sizeof(SCHED_TIME));
+
+        for(int b = 0; b < check_nb; ++b) {
+            if(fscanf(fptr, TIME_FMT, &p->bursts[b]) != 1 || p->bursts[b] < 1) {
+                printf("\nInvalid burst %d at process %d!\n", b, i);
+                fclose(fptr);
+                destroyProcessesIO(*process, i+1);
+                *process = NULL;
+                return -1;
+            }
+            if(b % 2 == 0) p->cpu_time += p->bursts[b];
+            else p->io_time += p->bursts[b];
+        }
+    }
+    fclose(fptr);
+    return n;
+}
+
+int selectReadyIO(IO_PROCESS *process, int *ready, int r_size, SCHED_POLICY policy, SCHED_TIME curr_time) {
+    /*
+        INTRODUCTION:
+            Picks the process to dispatch from the ready queue of the I/O burst simulation.
+
+        INPUT PARAMETERS:
+            - process (IO_PROCESS*): process array.
+            - ready (int*): ready queue (process indices in the order they became ready).
+            - r_size (int): number of processes in the ready queue.
+            - policy (SCHED_POLICY): scheduling algorithm.
+            - curr_time (SCHED_TIME): current time.
+
+        OUTPUT PARAMETERS:
+            - None.
+
+        RETURN VALUES:
+            - (int): position of the selected process in the ready queue.
+
+        APPROACH:
+            - FCFS and Round Robin take the head of the queue.
+            - Other algorithms compare the current burst (remaining time), response ratio
+              or priority, ties go to the process that became ready first.
+    */
+
+    int best = 0;
+    for(int k = 1; k < r_size; ++k) {
+        IO_PROCESS *a = &process[ready[k]], *b = &process[ready[best]];
+        switch(policy) {
+            case POLICY_SJF:
+            case POLICY_SRTF:
+                if(a->remaining < b->remaining) best = k;
+                break;
+            case POLICY_LJF:
+            case POLICY_LRTF:
+                if(a->remaining > b->remaining) best = k;
+                break;
+            case POLICY_PRIORITY:
+            case POLICY_PRIORITY_PREEMPTIVE:
+                if(a->priority < b->priority) best = k;
+                break;
+            case POLICY_HRRN: {
+                float ra = 1 + (float)(curr_time - a->ready_since) / a->remaining;
+                float rb = 1 + (float)(curr_time - b->ready_since) / b->remaining;
+                if(ra > rb) best = k;
+                break;
+            }
+            default:
+                return 0;
+        }
+    }
+    return best;
+}
+
+void appendGantt(GANTT **ghead, GANTT **gcurr, int pid, SCHED_TIME start_time, SCHED_TIME finish_time) {
+    /*
+        INTRODUCTION:
+            Appends an entry to a GANTT chart.
+
+        INPUT PARAMETERS:
+            - ghead (GANTT**): pointer to GANTT chart head.
+            - gcurr (GANTT**): pointer to last GANTT chart entry.
+            - pid (int): process executed (-1 for IDLE).
+            - start_time (SCHED_TIME), finish_time (SCHED_TIME): time slot of the entry.
+
+        OUTPUT PARAMETERS:
+            - Extends the last entry or appends a new one.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Ignore empty time slots.
+            - If the last entry has the same pid and ends at start_time, extend it.
+            - Otherwise allocate a new entry and link it at the end.
+    */
+
+    if(finish_time <= start_time) return;
+
+    if(*gcurr && (*gcurr)->pid == pid && (*gcurr)->finish_time == start_time) {
+        (*gcurr)->finish_time = finish_time;
+        return;
+    }
+
+    GANTT *gnew = ganttAlloc();
+    gnew->pid = pid;
+    gnew->start_time = start_time;
+    gnew->finish_time = finish_time;
+    gnew->next = NULL;
+
+    if(!*ghead) *ghead = *gcurr = gnew;
+    else {
+        (*gcurr)->next = gnew;
+        *gcurr = gnew;
+    }
+}
+
+GANTT* getGanttIO(IO_PROCESS *process, int n, SCHED_POLICY policy, SCHED_TIME time_slice, GANTT **io_gantt) {
+    /*
+        INTRODUCTION:
+            Simulates scheduling of processes with alternating CPU and I/O bursts on one CPU
+            and one I/O device.
+
+        INPUT PARAMETERS:
+            - process (IO_PROCESS*): process array.
+            - n (int): number of processes.
+            - policy (SCHED_POLICY): algorithm used to dispatch from the ready queue.
+            - time_slice (SCHED_TIME): time quantum (only used by Round Robin).
+            - io_gantt (GANTT**): if not NULL, receives the GANTT chart of the I/O device.
+
+        OUTPUT PARAMETERS:
+            - Constructs GANTT chart linked lists of the CPU and the I/O device.
+            - Fills wait and turnaround times of the processes.
+
+        RETURN VALUES:
+            - (GANTT*): pointer to GANTT chart head of the CPU.
+
+        APPROACH:
+            - Sort process indices on arrival time.
+            - At each time unit:
+                - Move arrived processes to the ready queue.
+                - Dispatch from the ready queue only, preempting the running process
+                  for preemptive algorithms or when its time slice expires (Round Robin).
+                - Run the CPU and the head of the blocked (device) queue for one time unit,
+                  processes in the ready queue accumulate wait time.
+                - A finished CPU burst blocks the process on the device queue (or completes it),
+                  a finished I/O burst wakes the process up into the ready queue.
+    */
+
+    if(n < 1 || !process) {
+        printf("\nInvalid number of Processes!\n");
+        return NULL;
+    }
+
+    if(policy == POLICY_ROUND_ROBIN && time_slice <= 0) {
+        printf("\nInvalid value of Time Slice!\n");
+        return NULL;
+    }
+
+    int *order = (int *)malloc(n*sizeof(int));
+    int *ready = (int *)malloc(n*sizeof(int));
+    int *blocked = (int *)malloc(n*sizeof(int));
+
+    for(int i = 0; i < n; i++) order[i] = i;
+    for(int i = 0; i < n-1; i++)                    // sort according to arrival time
+    {
+        for(int j = i+1; j < n; j++)
+        {
+            if(process[order[i]].arrive_time > process[order[j]].arrive_time)
+            {
+                int t = order[i];
+                order[i] = order[j];
+                order[j] = t;
+            }
+        }
+    }
+
+    for(int i = 0; i < n; i++) {
+        process[i].current = 0;
+        process[i].remaining = process[i].bursts[0];
+        process[i].wait_time = process[i].turnaround_time = 0;
+    }
+
+    int preemptive = (policy == POLICY_SRTF || policy == POLICY_PRIORITY_PREEMPTIVE || policy == POLICY_LRTF);
+    int r_size = 0, b_front = 0, b_size = 0, next_arrival = 0;
+    int running = -1, completed = 0;
+    SCHED_TIME slice_used = 0, curr_time = 0;
+    GANTT *ghead = NULL, *gcurr = NULL, *iohead = NULL, *iocurr = NULL;
+
+    while(completed < n) {
+        while(next_arrival < n && process[order[next_arrival]].arrive_time <= curr_time) {
+            int idx = order[next_arrival++];
+            process[idx].ready_since = curr_time;
+            ready[r_size++] = idx;
+        }
+
+        if(running != -1 && policy == POLICY_ROUND_ROBIN && slice_used == time_slice) {
+            process[running].ready_since = curr_time;           // time slice expired
+            ready[r_size++] = running;
+            running = -1;
+        }
+
+        if(r_size > 0) {
+            int pos = selectReadyIO(process, ready, r_size, policy, curr_time);
+            int cand = ready[pos];
+
+            if(running != -1 && preemptive) {                   // preempt if candidate is better
+                int better = 0;
+                if(policy == POLICY_SRTF) better = process[cand].remaining < process[running].remaining;
+                if(policy == POLICY_LRTF) better = process[cand].remaining > process[running].remaining;
+                if(policy == POLICY_PRIORITY_PREEMPTIVE) better = process[cand].priority < process[running].priority;
+
+                if(better) {
+                    process[running].ready_since = curr_time;
+                    ready[r_size++] = running;
+                    running = -1;
+                }
+            }
+
+            if(running == -1) {
+                running = cand;
+                for(int k = pos; k < r_size-1; k++) ready[k] = ready[k+1];
+                r_size--;
+                slice_used = 0;
+            }
+        }
+
+        for(int k = 0; k < r_size; k++) process[ready[k]].wait_time++;
+
+        appendGantt(&ghead, &gcurr, (running == -1) ? -1 : process[running].pid, curr_time, curr_time+1);
+        if(running != -1) {
+            process[running].remaining--;
+            slice_used++;
+        }
+
+        int io_idx = (b_size > 0) ? blocked[b_front] : -1;
+        appendGantt(&iohead, &iocurr, (io_idx == -1) ? -1 : process[io_idx].pid, curr_time, curr_time+1);
+        if(io_idx != -1) process[io_idx].remaining--;
+
+        curr_time++;
+
+        if(io_idx != -1 && process[io_idx].remaining == 0) {           // I/O finished: wake up
+            b_front = (b_front+1)%n;
+            b_size--;
+            process[io_idx].current++;
+            process[io_idx].remaining = process[io_idx].bursts[process[io_idx].current];
+            process[io_idx].ready_since = curr_time;
+            ready[r_size++] = io_idx;
+        }
+
+        if(running != -1 && process[running].remaining == 0) {
+            process[running].current++;
+            if(process[running].current < process[running].n_bursts) {     // block for I/O
+                process[running].remaining = process[running].bursts[process[running].current];
+                blocked[(b_front+b_size)%n] = running;
+                b_size++;
+            }
+            else {
+                completed++;
+                process[running].turnaround_time = curr_time - process[running].arrive_time;
+            }
+            running = -1;
+        }
+    }
+
+    free(order);
+    free(ready);
+    free(blocked);
+
+    if(io_gantt) *io_gantt = iohead;
+    else destroyGantt(iohead);
+    return ghead;
+}
+
+void displayProcessesIO(IO_PROCESS *process, int n, GANTT *cpu_gantt, GANTT *io_gantt) {
+    /*
+        INTRODUCTION:
+            Displays process table and CPU / I/O device utilization of an I/O burst simulation.
+
+        INPUT PARAMETERS:
+            - process (IO_PROCESS*): pointer to process array.
+            - n (int): number of processes.
+            - cpu_gantt (GANTT*): GANTT chart of the CPU.
+            - io_gantt (GANTT*): GANTT chart of the I/O device (may be NULL).
+
+        OUTPUT PARAMETERS:
+            - Prints process details and utilization to console.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Print every process with its CPU time, I/O time, wait and turnaround time.
+            - Walk both charts together and add up busy time of the CPU, the device,
+              and the time both are busy at once (overlap).
+    */
+
+    if(!process || !cpu_gantt) {
+        printf("\nCannot display processes!\n");
+        return;
+    }
+
+    long long waitSum = 0, tatSum = 0;
+    printf("\n\nWaiting time and Turn-around time:-");
+    printf("\nPrty\tPID\tCPU\tI/O\tWait\tTAT\n------------------------------------------------");
+    for(int i = 0; i < n; i++) {
+        printf("\n%d\tP%d\t" TIME_FMT "\t" TIME_FMT "\t" TIME_FMT "\t" TIME_FMT, process[i].priority, process[i].pid, process[i].cpu_time,
+               process[i].io_time, process[i].wait_time, process[i].turnaround_time);
+        waitSum += process[i].wait_time;
+        tatSum += process[i].turnaround_time;
+    }
+    printf("\n\nAverage Waiting time: %.2f", (double)waitSum/n);
+    printf("\nAverage Turn-around time: %.2f", (double)tatSum/n);
+
+    long long cpu_busy = 0, io_busy = 0, overlap = 0;
+    SCHED_TIME total = 0;
+    GANTT *c = cpu_gantt, *d = io_gantt;
+
+    for(GANTT *g = cpu_gantt; g; g = g->next) {
+        if(g->pid != -1) cpu_busy += g->finish_time - g->start_time;
+        total = g->finish_time;
+    }
+    for(GANTT *g = io_gantt; g; g = g->next)
+        if(g->pid != -1) io_busy += g->finish_time - g->start_time;
+
+    while(c && d) {                                 // intersect busy entries of both charts
+        if(c->pid != -1 && d->pid != -1) {
+            SCHED_TIME lo = (c->start_time > d->start_time) ? c->start_time : d->start_time;
+            SCHED_TIME hi = (c->finish_time < d->finish_time) ? c->finish_time : d->finish_time;
+            if(hi > lo) overlap += hi - lo;
+        }
+        if(c->finish_time < d->finish_time) c = c->next;
+        else d = d->next;
+    }
+
+    if(total == 0) total = 1;
+    printf("\n\nCPU utilization: %.2f%%", 100.0*cpu_busy/total);
+    printf("\nI/O device utilization: %.2f%%", 100.0*io_busy/total);
+    printf("\nCPU and I/O overlap: %.2f%%", 100.0*overlap/total);
+    printf("\n----------------------------------------------------------------\n");
+}
+
+void destroyProcessesIO(IO_PROCESS *process, int n) {
+    /*
+        INTRODUCTION:
+            Frees allocated memory for an IO_PROCESS array and its bursts.
+
+        INPUT PARAMETERS:
+            - process (IO_PROCESS*): pointer to process array.
+            - n (int): number of processes.
+
+        OUTPUT PARAMETERS:
+            - Frees dynamically allocated memory.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Use free() on the bursts of every process, then on the array.
+    */
+
+    if(!process) return;
+    for(int i = 0; i < n; i++)
+        if(process[i].bursts) free(process[i].bursts);
+    free(process);
+}
+
+void heapInit(HEAP *heap, int (*less)(void *, int, int), void *ctx) {
+    /*
+        INTRODUCTION:
+            Initializes an empty heap.
+
+        INPUT PARAMETERS:
+            - heap (HEAP*): heap to initialize.
+            - less (function): ordering of two indices.
+            - ctx (void*): context passed to less.
+
+        OUTPUT PARAMETERS:
+            - Fills the heap structure.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Start with a small array, it grows on demand in heapPush.
+    */
+
+    heap->capacity = 16;
+    heap->size = 0;
+    heap->data = (int *)malloc(heap->capacity*sizeof(int));
+    heap->less = less;
+    heap->ctx = ctx;
+}
+
+void heapPush(HEAP *heap, int idx) {
+    /*
+        INTRODUCTION:
+            Inserts an index into the heap in O(log n).
+
+        INPUT PARAMETERS:
+            - heap (HEAP*): heap.
+            - idx (int): index to insert.
+
+        OUTPUT PARAMETERS:
+            - Modifies the heap.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Double the array if it is full.
+            - Place idx at the end and sift it up while it comes before its parent.
+    */
+
+    if(heap->size == heap->capacity) {
+        heap->capacity *= 2;
+        heap->data = (int *)realloc(heap->data, heap->capacity*sizeof(int));
+    }
+
+    int pos = heap->size++;
+    while(pos > 0) {
+        int parent = (pos-1)/2;
+        if(!heap->less(heap->ctx, idx, heap->data[parent])) break;
+        heap->data[pos] = heap->data[parent];
+        pos = parent;
+    }
+    heap->data[pos] = idx;
+}
+
+int heapPop(HEAP *heap) {
+    /*
+        INTRODUCTION:
+            Removes the smallest index from the heap in O(log n).
+
+        INPUT PARAMETERS:
+            - heap (HEAP*): heap.
+
+        OUTPUT PARAMETERS:
+            - Modifies the heap.
+
+        RETURN VALUES:
+            - (int): removed index, -1 if the heap is empty.
+
+        APPROACH:
+            - Take the root, move the last index to the root and sift it down.
+    */
+
+    if(heap->size == 0) return -1;
+
+    int top = heap->data[0];
+    int last = heap->data[--heap->size];
+    int pos = 0;
+
+    while(1) {
+        int child = 2*pos+1;
+        if(child >= heap->size) break;
+        if(child+1 < heap->size && heap->less(heap->ctx, heap->data[child+1], heap->data[child])) child++;
+        if(!heap->less(heap->ctx, heap->data[child], last)) break;
+        heap->data[pos] = heap->data[child];
+        pos = child;
+    }
+    if(heap->size > 0) heap->data[pos] = last;
+    return top;
+}
+
+void heapDestroy(HEAP *heap) {
+    /*
+        INTRODUCTION:
+            Frees allocated memory of a heap.
+
+        INPUT PARAMETERS:
+            - heap (HEAP*): heap.
+
+        OUTPUT PARAMETERS:
+            - Frees dynamically allocated memory.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Use free() on the array.
+    */
+
+    if(heap->data) free(heap->data);
+    heap->data = NULL;
+    heap->size = heap->capacity = 0;
+}
+
+int runqLess(void *ctx, int a, int b) {
+    // Heap ordering of the run queue: priority, then index
+    PROCESS_HOT *hot = (PROCESS_HOT *)ctx;
+    if(hot[a].priority != hot[b].priority) return hot[a].priority < hot[b].priority;
+    return a < b;
+}
+
+void runqInit(RUNQUEUE *rq, PROCESS_HOT *hot, int n) {
+    /*
+        INTRODUCTION:
+            Initializes an empty run queue for the processes of hot.
+
+        INPUT PARAMETERS:
+            - rq (RUNQUEUE*): run queue to initialize.
+            - hot (PROCESS_HOT*): processes.
+            - n (int): number of processes.
+
+        OUTPUT PARAMETERS:
+            - Fills the run queue structure.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Use one list per priority between the lowest and highest priority of hot if there are
+              at most RUNQ_MAX_LEVELS of them, else a heap ordered on priority, then index.
+    */
+
+    rq->hot = hot;
+    rq->size = 0;
+
+    int lo = INT_MAX, hi = INT_MIN;
+    for(int i = 0; i < n; i++) {
+        if(hot[i].priority < lo) lo = hot[i].priority;
+        if(hot[i].priority > hi) hi = hot[i].priority;
+    }
+
+    if(n < 1 || (long long)hi - lo + 1 > RUNQ_MAX_LEVELS) {
+        rq->levels = 0;
+        heapInit(&rq->heap, runqLess, hot);
+        return;
+    }
+
+    rq->base = lo;
+    rq->levels = hi - lo + 1;
+    rq->summary = 0;
+    rq->bitmap = (unsigned long long *)schedCalloc((rq->levels + 63) / 64, sizeof(unsigned long long));
+    rq->head = (int *)schedAlloc(rq->levels*sizeof(int));
+    rq->tail = (int *)schedAlloc(rq->levels*sizeof(int));
+    rq->next = (int *)schedAlloc(n*sizeof(int));
+    for(int p = 0; p < rq->levels; p++) rq->head[p] = rq->tail[p] = -1;
+}
+
+void runqPush(RUNQUEUE *rq, int idx) {
+    /*
+        INTRODUCTION:
+            Queues a process in O(1) (O(log n) with the heap).
+
+        INPUT PARAMETERS:
+            - rq (RUNQUEUE*): run queue.
+            - idx (int): index of the process.
+
+        OUTPUT PARAMETERS:
+            - Appends idx to the list of its priority and sets the bits of that list.
+
+        RETURN VALUES:
+            - None.
+    */
+
+    rq->size++;
+    if(!rq->levels) {
+        heapPush(&rq->heap, idx);
+        return;
+    }
+
+    int p = rq->hot[idx].priority - rq->base;
+    rq->next[idx] = -1;
+    if(rq->head[p] == -1) {
+        rq->head[p] = idx;
+        rq->bitmap[p / 64] |= 1ULL << (p % 64);
+        rq->summary |= 1ULL << (p / 64);
+    }
+    else rq->next[rq->tail[p]] = idx;
+    rq->tail[p] = idx;
+}
+
+int runqPeek(RUNQUEUE *rq) {
+    /*
+        INTRODUCTION:
+            Finds the process with the highest priority (lowest value) in O(1).
+
+        INPUT PARAMETERS:
+            - rq (RUNQUEUE*): run queue.
+
+        RETURN VALUES:
+            - (int): its index, the first one queued among equal priorities (the lowest index with
+              the heap, the same process when indices are queued in increasing order); -1 if empty.
+
+        APPROACH:
+            - The lowest set bit of summary gives the first non-empty bitmap word, the lowest set bit
+              of that word gives the list.
+    */
+
+    if(rq->size == 0) return -1;
+    if(!rq->levels) return rq->heap.data[0];
+
+    int word = __builtin_ctzll(rq->summary);
+    int p = word*64 + __builtin_ctzll(rq->bitmap[word]);
+    return rq->head[p];
+}
+
+int runqPop(RUNQUEUE *rq) {
+    // Removes and returns the process runqPeek() finds, -1 if the queue is empty
+    int idx = runqPeek(rq);
+    if(idx == -1) return -1;
+
+    rq->size--;
+    if(!rq->levels) return heapPop(&rq->heap);
+
+    int p = rq->hot[idx].priority - rq->base;
+    rq->head[p] = rq->next[idx];
+    if(rq->head[p] == -1) {
+        rq->bitmap[p / 64] &= ~(1ULL << (p % 64));
+        if(!rq->bitmap[p / 64]) rq->summary &= ~(1ULL << (p / 64));
+    }
+    return idx;
+}
+
+void runqDestroy(RUNQUEUE *rq) {
+    // Frees allocated memory of a run queue
+    if(!rq->levels) {
+        heapDestroy(&rq->heap);
+        return;
+    }
+    schedFree(rq->bitmap);
+    schedFree(rq->head);
+    schedFree(rq->tail);
+    schedFree(rq->next);
+}
+
+int eventLess(void *ctx, int a, int b) {
+    // Heap ordering of an event queue: time, then the order given to eventInit
+    EVENT_QUEUE *q = (EVENT_QUEUE *)ctx;
+    if(q->time[a] != q->time[b]) return q->time[a] < q->time[b];
+    return q->less(q->ctx, a, b);
+}
+
+void eventInit(EVENT_QUEUE *q, EVENTQ_KIND kind, int (*less)(void *, int, int), void *ctx) {
+    /*
+        INTRODUCTION:
+            Initializes an empty event queue.
+
+        INPUT PARAMETERS:
+            - q (EVENT_QUEUE*): event queue to initialize.
+            - kind (EVENTQ_KIND): EVENTQ_HEAP, EVENTQ_WHEEL, or EVENTQ_AUTO to let the queue choose.
+            - less (function): ordering of two indices whose events happen at the same time.
+            - ctx (void*): context passed to less.
+
+        OUTPUT PARAMETERS:
+            - Fills the event queue structure.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Start with empty wheel slots and small arrays, they grow on demand in eventPush.
+    */
+
+    q->kind = kind;
+    q->size = 0;
+    q->capacity = 16;
+    q->time = (SCHED_TIME *)malloc(q->capacity*sizeof(SCHED_TIME));
+    q->next = (int *)malloc(q->capacity*sizeof(int));
+    q->less = less;
+    q->ctx = ctx;
+    heapInit(&q->due, eventLess, q);
+    q->now = 0;
+    q->next_time = -1;
+    q->check_at = EVENTQ_WHEEL_MIN;
+    memset(q->occupied, 0, sizeof(q->occupied));
+    memset(q->slot, -1, sizeof(q->slot));
+}
+
+void wheelInsert(EVENT_QUEUE *q, int idx) {
+    // Puts an event in the slot for its time, or in the due heap if it happens at time now
+    SCHED_TIME t = q->time[idx];
+    if(t == q->now) {
+        heapPush(&q->due, idx);
+        return;
+    }
+
+    unsigned long long diff = (unsigned long long)t ^ (unsigned long long)q->now;
+    int level = (63 - __builtin_clzll(diff)) / WHEEL_BITS;
+    int k = (int)(((unsigned long long)t >> (level*WHEEL_BITS)) & ((1 << WHEEL_BITS) - 1));
+    q->next[idx] = q->slot[level][k];
+    q->slot[level][k] = idx;
+    q->occupied[level] |= 1ULL << k;
+    if(q->next_time != -1 && t < q->next_time) q->next_time = t;
+}
+
+SCHED_TIME wheelFirstTime(EVENT_QUEUE *q, int *level, int *k) {
+    // Finds the first non-empty slot and the earliest time in it (the wheel must not be empty)
+    int l = 0;
+    while(!q->occupied[l]) l++;
+    *level = l;
+    *k = __builtin_ctzll(q->occupied[l]);
+
+    if(l == 0) return q->now - (q->now & ((1 << WHEEL_BITS) - 1)) + *k;     // one time per slot
+    if(q->next_time != -1) return q->next_time;
+
+    SCHED_TIME first = TIME_MAX;
+    for(int idx = q->slot[l][*k]; idx != -1; idx = q->next[idx])
+        if(q->time[idx] < first) first = q->time[idx];
+    return first;
+}
+
+int eventPush(EVENT_QUEUE *q, int idx, SCHED_TIME time) {
+    /*
+        INTRODUCTION:
+            Queues the event of an index in O(log n) with the heap, O(1) with the timing wheel.
+
+        INPUT PARAMETERS:
+            - q (EVENT_QUEUE*): event queue.
+            - idx (int): index (at most one event per index is queued).
+            - time (SCHED_TIME): time of the event, not before the last event taken out.
+
+        OUTPUT PARAMETERS:
+            - Modifies the event queue.
+
+        RETURN VALUES:
+            - (int): 0 if successful, -1 if any error.
+
+        APPROACH:
+            - Grow the per index arrays if needed.
+            - EVENTQ_AUTO: once the queue reaches EVENTQ_WHEEL_MIN events (then twice as many, ...),
+              switch to the wheel if the times are dense: at most EVENTQ_WHEEL_SPREAD time units
+              per queued event between now and the latest event.
+    */
+
+    if(time < q->now) {
+        printf("\nEvent at time " TIME_FMT " is earlier than the last one!\n", time);
+        return -1;
+    }
+
+    if(idx >= q->capacity) {
+        while(idx >= q->capacity) q->capacity *= 2;
+        q->time = (SCHED_TIME *)realloc(q->time, q->capacity*sizeof(SCHED_TIME));
+        q->next = (int *)realloc(q->next, q->capacity*sizeof(int));
+    }
+    q->time[idx] = time;
+    q->size++;
+
+    if(q->kind == EVENTQ_WHEEL) {
+        wheelInsert(q, idx);
+        return 0;
+    }
+    heapPush(&q->due, idx);
+
+    if(q->kind == EVENTQ_AUTO && q->size >= q->check_at) {
+        SCHED_TIME last = q->now;
+        for(int i = 0; i < q->due.size; i++)
+            if(q->time[q->due.data[i]] > last) last = q->time[q->due.data[i]];
+
+        if((long long)last - q->now > (long long)q->size * EVENTQ_WHEEL_SPREAD) {
+            q->check_at = (q->check_at > INT_MAX/2) ? INT_MAX : 2*q->check_at;
+            return 0;
+        }
+
+        int count = q->due.size;
+        int *held = (int *)malloc(count*sizeof(int));
+        memcpy(held, q->due.data, count*sizeof(int));
+        q->due.size = 0;
+        q->kind = EVENTQ_WHEEL;
+        q->next_time = -1;
+        for(int i = 0; i < count; i++) wheelInsert(q, held[i]);
+        free(held);
+    }
+    return 0;
+}
+
+SCHED_TIME eventNextTime(EVENT_QUEUE *q) {
+    /*
+        INTRODUCTION:
+            Finds the time of the earliest queued event.
+
+        INPUT PARAMETERS:
+            - q (EVENT_QUEUE*): event queue.
+
+        RETURN VALUES:
+            - (SCHED_TIME): its time, TIME_MAX if the queue is empty.
+
+        APPROACH:
+            - Heap: time of the root.
+            - Wheel: now if events are due, else the earliest time of the first non-empty slot.
+              Slots above level 0 are scanned once, the result is kept in next_time until
+              the slot is taken apart.
+    */
+
+    if(q->size == 0) return TIME_MAX;
+    if(q->kind != EVENTQ_WHEEL) return q->time[q->due.data[0]];
+    if(q->due.size > 0) return q->now;
+
+    int level, k;
+    SCHED_TIME first = wheelFirstTime(q, &level, &k);
+    if(level > 0) q->next_time = first;
+    return first;
+}
+
+int eventPop(EVENT_QUEUE *q) {
+    /*
+        INTRODUCTION:
+            Removes the earliest event (the first one in the order of less among equal times).
+
+        INPUT PARAMETERS:
+            - q (EVENT_QUEUE*): event queue.
+
+        OUTPUT PARAMETERS:
+            - Modifies the event queue.
+
+        RETURN VALUES:
+            - (int): index of the event, -1 if the queue is empty.
+
+        APPROACH:
+            - Heap: O(log n).
+            - Wheel: when no event is due, empty the first non-empty slot. At level 0 all its events
+              happen at the same time, which becomes now. Above level 0, now becomes the earliest
+              time of the slot and its events move down to lower levels (or become due), so an
+              event moves at most once per level: O(1) per event for a bounded range of times.
+              Equal times are ordered by less in the due heap, which is small unless many events
+              happen at the same time.
+    */
+
+    if(q->size == 0) return -1;
+
+    if(q->kind == EVENTQ_WHEEL && q->due.size == 0) {
+        int level, k;
+        q->now = wheelFirstTime(q, &level, &k);
+        q->next_time = -1;
+
+        int idx = q->slot[level][k];
+        q->slot[level][k] = -1;
+        q->occupied[level] &= ~(1ULL << k);
+        while(idx != -1) {
+            int next = q->next[idx];
+            wheelInsert(q, idx);
+            idx = next;
+        }
+    }
+
+    int idx = heapPop(&q->due);
+    q->size--;
+    q->now = q->time[idx];
+    return idx;
+}
+
+int eventQueued(EVENT_QUEUE *q, int *idx) {
+    /*
+        INTRODUCTION:
+            Lists the indices of every queued event, in no particular order.
+
+        INPUT PARAMETERS:
+            - q (EVENT_QUEUE*): event queue.
+            - idx (int*): array of at least q->size indices to fill.
+
+        OUTPUT PARAMETERS:
+            - Fills idx.
+
+        RETURN VALUES:
+            - (int): number of queued events.
+
+        APPROACH:
+            - The due heap, then the slots of every level of the wheel.
+    */
+
+    int count = 0;
+    for(int k = 0; k < q->due.size; k++) idx[count++] = q->due.data[k];
+    if(q->kind == EVENTQ_WHEEL)
+        for(int l = 0; l < WHEEL_LEVELS; l++)
+            for(int k = 0; q->occupied[l] && k < (1 << WHEEL_BITS); k++)
+                for(int i = q->slot[l][k]; i != -1; i = q->next[i]) idx[count++] = i;
+    return count;
+}
+
+void eventDestroy(EVENT_QUEUE *q) {
+    // Frees allocated memory of an event queue
+    heapDestroy(&q->due);
+    free(q->time);
+    free(q->next);
+    q->time = NULL;
+    q->next = NULL;
+    q->size = q->capacity = 0;
+}
+
+
+int agingLess(void *ctx, int a, int b) {
+    /*
+        INTRODUCTION:
+            Orders the ready heap of priority scheduling with aging.
+
+        INPUT PARAMETERS:
+            - ctx (void*): AGING state.
+            - a, b (int): process indices.
+
+        OUTPUT PARAMETERS:
+            - None.
+
+        RETURN VALUES:
+            - (int): 1 if a comes before b, else 0.
+
+        APPROACH:
+            - Effective priority at time t is priority - (t - ready_since) / interval.
+              Scaled by interval this is priority*interval + ready_since - t, and since t is the
+              same for every waiting process the key priority*interval + ready_since never changes
+              while a process waits, so the heap never has to be rebuilt as time passes.
+            - Without aging the key is the priority. Ties go to the lower index (earlier arrival).
+    */
+
+    AGING *ag = (AGING *)ctx;
+    long long ka = ag->hot[a].priority, kb = ag->hot[b].priority;
+
+    if(ag->interval > 0) {
+        ka = ka*ag->interval + ag->ready_since[a];
+        kb = kb*ag->interval + ag->ready_since[b];
+    }
+    if(ka != kb) return ka < kb;
+    return a < b;
+}
+
+GANTT* getGanttPriorityAgingCore(PROCESS *process, int n, SCHED_TIME aging_interval, int preemptive) {
+    /*
+        INTRODUCTION:
+            Simulates priority scheduling where waiting processes age towards higher priority.
+
+        INPUT PARAMETERS:
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+            - aging_interval (SCHED_TIME): waiting time after which priority improves by one level (0 = no aging).
+            - preemptive (int): 1 for preemptive, 0 for non-preemptive scheduling.
+
+        OUTPUT PARAMETERS:
+            - Constructs GANTT chart linked list.
+
+        RETURN VALUES:
+            - (GANTT*): pointer to GANTT chart head.
+
+        APPROACH:
+            - Sort the workload on arrival time, or on priority if arrival times are same.
+            - Keep ready processes in a heap ordered by agingLess and jump from event to event
+              (arrival, completion, or a waiting process aging past the running one).
+            - The running process does not age. A waiting process preempts it once its priority
+              has improved by whole levels beyond the running one, i.e. once
+              priority - (t - ready_since) / aging_interval (rounded down) < running priority.
+              The heap top is always the first process to get there.
+            - A preempted process re-enters the heap with ready_since = preemption time.
+    */
+
+    if(n < 1 || !process) {
+        printf("\nInvalid number of Processes!\n");
+        return NULL;
+    }
+
+    if(aging_interval < 0) {
+        printf("\nInvalid value of Aging Interval!\n");
+        return NULL;
+    }
+
+    WORKLOAD *w = getWorkload(process, n);
+    sortWorkload(w, SORT_PRIORITY);
+    PROCESS_HOT *hot = w->hot;
+    PROCESS_OUT *out = w->out;
+
+    AGING ag;
+    HEAP ready;
+    ag.hot = hot;
+    ag.ready_since = (SCHED_TIME *)malloc(n*sizeof(SCHED_TIME));
+    ag.interval = aging_interval;
+    heapInit(&ready, agingLess, &ag);
+
+    GANTT *ghead = NULL, *gcurr = NULL;
+    int completed = 0, next = 0, running = -1;
+    SCHED_TIME curr_time = 0, run_start = 0;
+
+    while(completed < n) {
+        while(next < n && hot[next].arrive_time <= curr_time) {
+            ag.ready_since[next] = hot[next].arrive_time;
+            heapPush(&ready, next++);
+        }
+
+        if(running == -1) {
+            if(ready.size == 0) {                   // system is IDLE until the next arrival
+                appendGantt(&ghead, &gcurr, -1, curr_time, hot[next].arrive_time);
+                curr_time = hot[next].arrive_time;
+                continue;
+            }
+            running = heapPop(&ready);
+            run_start = curr_time;
+        }
+
+        SCHED_TIME stop = curr_time + hot[running].burst_time;
+
+        if(preemptive) {
+            if(next < n && hot[next].arrive_time < stop) stop = hot[next].arrive_time;
+
+            if(ready.size > 0 && aging_interval > 0) {      // when does the heap top age past the running process?
+                int top = ready.data[0];
+                long long overtake = ag.ready_since[top] +
+                    (long long)(hot[top].priority - hot[running].priority + 1)*aging_interval;
+                if(overtake <= curr_time) overtake = curr_time + 1;
+                if(overtake < stop) stop = (SCHED_TIME)overtake;
+            }
+        }
+
+        hot[running].burst_time -= stop - curr_time;
+        curr_time = stop;
+
+        if(hot[running].burst_time == 0) {
+            appendGantt(&ghead, &gcurr, w->pid[running], run_start, curr_time);
+            completed++;
+            out[running].turnaround_time = curr_time - hot[running].arrive_time;
+            out[running].wait_time = out[running].turnaround_time - w->initial_burst[running];
+            running = -1;
+            continue;
+        }
+
+        while(next < n && hot[next].arrive_time <= curr_time) {
+            ag.ready_since[next] = hot[next].arrive_time;
+            heapPush(&ready, next++);
+        }
+
+        if(ready.size > 0) {
+            int top = ready.data[0];
+            long long effective = hot[top].priority;
+            if(aging_interval > 0) effective -= (curr_time - ag.ready_since[top]) / aging_interval;
+
+            if(effective < hot[running].priority) {      // preempt
+                appendGantt(&ghead, &gcurr, w->pid[running], run_start, curr_time);
+                ag.ready_since[running] = curr_time;
+                heapPush(&ready, running);
+                running = -1;
+            }
+        }
+    }
+
+    storeWorkload(w, process);
+    heapDestroy(&ready);
+    free(ag.ready_since);
+    destroyWorkload(w);
+    return ghead;
+}
+
+GANTT* getGanttPriorityAging(PROCESS *process, int n, SCHED_TIME aging_interval) {
+    /*
+        INTRODUCTION:
+            Simulates non-preemptive priority scheduling with aging.
+
+        INPUT PARAMETERS:
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+            - aging_interval (SCHED_TIME): waiting time after which priority improves by one level (0 = no aging).
+
+        OUTPUT PARAMETERS:
+            - Constructs GANTT chart linked list.
+
+        RETURN VALUES:
+            - (GANTT*): pointer to GANTT chart head.
+
+        APPROACH:
+            - When the CPU is free pick the ready process with the best effective priority
+              (see getGanttPriorityAgingCore).
+    */
+
+    return getGanttPriorityAgingCore(process, n, aging_interval, 0);
+}
+
+GANTT* getGanttPriorityPreemptiveAging(PROCESS *process, int n, SCHED_TIME aging_interval) {
+    /*
+        INTRODUCTION:
+            Simulates preemptive priority scheduling with aging.
+
+        INPUT PARAMETERS:
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+            - aging_interval (SCHED_TIME): waiting time after which priority improves by one level (0 = no aging).
+
+        OUTPUT PARAMETERS:
+            - Constructs GANTT chart linked list.
+
+        RETURN VALUES:
+            - (GANTT*): pointer to GANTT chart head.
+
+        APPROACH:
+            - Preempt the running process when a process arrives with a higher priority
+              or a waiting process ages past it (see getGanttPriorityAgingCore).
+    */
+
+    return getGanttPriorityAgingCore(process, n, aging_interval, 1);
+}
+
+void displayStarvation(PROCESS *process, int n) {
+    /*
+        INTRODUCTION:
+            Displays starvation metrics: longest wait and wait time per priority class.
+
+        INPUT PARAMETERS:
+            - process (PROCESS*): pointer to process array (after scheduling).
+            - n (int): number of processes.
+
+        OUTPUT PARAMETERS:
+            - Prints the metrics to console.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Find the process with the longest wait.
+            - Collect the distinct priorities in ascending order, then for every class
+              print the number of processes, average, minimum and maximum wait.
+    */
+
+    if(!process || n < 1) {
+        printf("\nCannot display processes!\n");
+        return;
+    }
+
+    int worst = 0, n_class = 0;
+    int *classes = (int *)malloc(n*sizeof(int));
+
+    for(int i = 0; i < n; i++) {
+        if(process[i].wait_time > process[worst].wait_time) worst = i;
+
+        int k = 0;
+        while(k < n_class && classes[k] < process[i].priority) k++;
+        if(k < n_class && classes[k] == process[i].priority) continue;
+        for(int m = n_class; m > k; --m) classes[m] = classes[m-1];
+        classes[k] = process[i].priority;
+        n_class++;
+    }
+
+    printf("\n\nStarvation:-");
+    printf("\nMaximum wait: " TIME_FMT " (P%d, priority %d)", process[worst].wait_time, process[worst].pid, process[worst].priority);
+    printf("\n\nPrty\tCount\tAvg\tMin\tMax\n----------------------------------------");
+    for(int k = 0; k < n_class; k++) {
+        long long sum = 0;
+        int count = 0;
+        SCHED_TIME min_wait = TIME_MAX, max_wait = -1;
+        for(int i = 0; i < n; i++) {
+            if(process[i].priority != classes[k]) continue;
+            sum += process[i].wait_time;
+            count++;
+            if(process[i].wait_time < min_wait) min_wait = process[i].wait_time;
+            if(process[i].wait_time > max_wait) max_wait = process[i].wait_time;
+        }
+        printf("\n%d\t%d\t%.2f\t" TIME_FMT "\t" TIME_FMT, classes[k], count, (double)sum/count, min_wait, max_wait);
+    }
+    printf("\n----------------------------------------------------------------\n");
+    free(classes);
+}
+
+int schedulerTieLess(SCHEDULER *s, int a, int b) {
+    /*
+        INTRODUCTION:
+            Breaks ties between two processes the same way the sorting step of getGantt* does.
+
+        INPUT PARAMETERS:
+            - s (SCHEDULER*): scheduler.
+            - a, b (int): process indices.
+
+        OUTPUT PARAMETERS:
+            - None.
+
+        RETURN VALUES:
+            - (int): 1 if a comes before b, else 0.
+
+        APPROACH:
+            - Compare arrival time, then the secondary sort key of the algorithm
+              (burst time, burst time descending or priority), then order of submission.
+    */
+
+    PROCESS *pa = &s->process[a], *pb = &s->process[b];
+    if(pa->arrive_time != pb->arrive_time) return pa->arrive_time < pb->arrive_time;
+
+    switch(s->policy) {
+        case POLICY_SJF: case POLICY_HRRN: case POLICY_SRTF:
+            if(pa->initial_burst != pb->initial_burst) return pa->initial_burst < pb->initial_burst;
+            break;
+        case POLICY_LJF: case POLICY_LRTF:
+            if(pa->initial_burst != pb->initial_burst) return pa->initial_burst > pb->initial_burst;
+            break;
+        case POLICY_PRIORITY: case POLICY_PRIORITY_PREEMPTIVE:
+            if(pa->priority != pb->priority) return pa->priority < pb->priority;
+            break;
+        default:
+            break;
+    }
+    return a < b;
+}
+
+int schedulerPendingLess(void *ctx, int a, int b) {
+    // Pending processes are admitted in the order getGantt* sorts them
+    return schedulerTieLess((SCHEDULER *)ctx, a, b);
+}
+
+int schedulerReadyLess(void *ctx, int a, int b) {
+    // Order of the ready heap: key of the algorithm, then the tie breaker
+    SCHEDULER *s = (SCHEDULER *)ctx;
+    PROCESS *pa = &s->process[a], *pb = &s->process[b];
+
+    switch(s->policy) {
+        case POLICY_SJF: case POLICY_SRTF:
+            if(pa->burst_time != pb->burst_time) return pa->burst_time < pb->burst_time;
+            break;
+        case POLICY_LJF: case POLICY_LRTF:
+            if(pa->burst_time != pb->burst_time) return pa->burst_time > pb->burst_time;
+            break;
+        case POLICY_PRIORITY: case POLICY_PRIORITY_PREEMPTIVE:
+            if(pa->priority != pb->priority) return pa->priority < pb->priority;
+            break;
+        default:
+            break;
+    }
+    return schedulerTieLess(s, a, b);
+}
+
+SCHEDULER* createScheduler(SCHED_POLICY policy, SCHED_TIME time_slice) {
+    /*
+        INTRODUCTION:
+            Creates an online scheduler that extends its schedule as processes are submitted.
+
+        INPUT PARAMETERS:
+            - policy (SCHED_POLICY): scheduling algorithm.
+            - time_slice (SCHED_TIME): time quantum (only used by Round Robin).
+
+        OUTPUT PARAMETERS:
+            - None.
+
+        RETURN VALUES:
+            - (SCHEDULER*): pointer to the new scheduler, NULL if any error.
+
+        APPROACH:
+            - Validate the arguments, allocate the structure, the process array and the queues.
+    */
+
+    if(policy < 0 || policy >= POLICY_COUNT) {
+        printf("\nInvalid scheduling algorithm!\n");
+        return NULL;
+    }
+    if(policy == POLICY_ROUND_ROBIN && time_slice <= 0) {
+        printf("\nInvalid value of Time Slice!\n");
+        return NULL;
+    }
+
+    SCHEDULER *s = (SCHEDULER *)calloc(1, sizeof(SCHEDULER));
+    s->policy = policy;
+    s->time_slice = time_slice;
+    s->capacity = 16;
+    s->process = (PROCESS *)malloc(s->capacity*sizeof(PROCESS));
+    s->queue = (int *)malloc(s->capacity*sizeof(int));
+    s->running = -1;
+    s->idle_since = 0;
+    eventInit(&s->pending, EVENTQ_AUTO, schedulerPendingLess, s);
+    heapInit(&s->ready, schedulerReadyLess, s);
+    return s;
+}
+
+int schedulerUseEventQueue(SCHEDULER *s, EVENTQ_KIND kind) {
+    /*
+        INTRODUCTION:
+            Chooses the queue of pending arrivals of an online scheduler.
+
+        INPUT PARAMETERS:
+            - s (SCHEDULER*): scheduler.
+            - kind (EVENTQ_KIND): EVENTQ_AUTO (default), EVENTQ_HEAP or EVENTQ_WHEEL.
+
+        OUTPUT PARAMETERS:
+            - Replaces the empty event queue.
+
+        RETURN VALUES:
+            - (int): 0 if successful, -1 if any error.
+
+        APPROACH:
+            - Only allowed before the first submission, the schedule does not depend on the choice.
+    */
+
+    if(!s) return -1;
+    if(s->n > 0) {
+        printf("\nEvent queue must be chosen before processes are submitted!\n");
+        return -1;
+    }
+    eventDestroy(&s->pending);
+    eventInit(&s->pending, kind, schedulerPendingLess, s);
+    return 0;
+}
+
+int schedulerSubmit(SCHEDULER *s, PROCESS process) {
+    /*
+        INTRODUCTION:
+            Submits a new process to an online scheduler in O(log n).
+
+        INPUT PARAMETERS:
+            - s (SCHEDULER*): scheduler.
+            - process (PROCESS): the process (pid, arrive_time, burst_time, priority are used).
+
+        OUTPUT PARAMETERS:
+            - Stores a copy of the process in the scheduler.
+
+        RETURN VALUES:
+            - (int): index of the process in s->process, -1 if any error.
+
+        APPROACH:
+            - A process cannot arrive before the time the schedule has been built up to.
+            - Grow the arrays if needed (the queues hold indices, so they stay valid).
+            - Queue the arrival of the process as an event, it enters the ready queue on arrival.
+    */
+
+    if(!s) return -1;
+    if(process.arrive_time < s->curr_time || process.burst_time <= 0) {
+        printf("\nInvalid value for arrival/burst time of process %d!\n", process.pid);
+        return -1;
+    }
+
+    if(s->n == s->capacity) {
+        int *queue = (int *)malloc(2*s->capacity*sizeof(int));
+        for(int k = 0; k < s->q_size; k++) queue[k] = s->queue[(s->q_front+k)%s->capacity];
+        free(s->queue);
+        s->queue = queue;
+        s->q_front = 0;
+        s->capacity *= 2;
+        s->process = (PROCESS *)realloc(s->process, s->capacity*sizeof(PROCESS));
+    }
+
+    int idx = s->n++;
+    s->process[idx] = process;
+    s->process[idx].initial_burst = process.burst_time;
+    s->process[idx].wait_time = s->process[idx].turnaround_time = 0;
+    eventPush(&s->pending, idx, process.arrive_time);
+    return idx;
+}
+
+void schedulerEmit(SCHEDULER *s, int pid, SCHED_TIME start_time, SCHED_TIME finish_time) {
+    // Appends a finished entry to the unpolled part of the GANTT chart
+    if(finish_time <= start_time) return;
+
+    if(pid == -1 && s->gcurr && s->gcurr->pid == -1 && s->gcurr->finish_time == start_time) {
+        s->gcurr->finish_time = finish_time;
+        return;
+    }
+
+    GANTT *gnew = ganttAlloc();
+    gnew->pid = pid;
+    gnew->start_time = start_time;
+    gnew->finish_time = finish_time;
+    gnew->next = NULL;
+
+    if(!s->ghead) s->ghead = s->gcurr = gnew;
+    else {
+        s->gcurr->next = gnew;
+        s->gcurr = gnew;
+    }
+}
+
+void schedulerAdmit(SCHEDULER *s) {
+    // Moves every pending process that has arrived by curr_time to the ready queue
+    while(s->pending.size > 0 && eventNextTime(&s->pending) <= s->curr_time) {
+        int idx = eventPop(&s->pending);
+        if(s->policy == POLICY_ROUND_ROBIN || s->policy == POLICY_HRRN) {
+            s->queue[(s->q_front+s->q_size)%s->capacity] = idx;
+            s->q_size++;
+        }
+        else heapPush(&s->ready, idx);
+    }
+}
+
+int schedulerPick(SCHEDULER *s) {
+    // Removes and returns the next process to dispatch, -1 if nothing is ready
+    if(s->policy == POLICY_ROUND_ROBIN) {
+        if(s->q_size == 0) return -1;
+        int idx = s->queue[s->q_front];
+        s->q_front = (s->q_front+1)%s->capacity;
+        s->q_size--;
+        return idx;
+    }
+
+    if(s->policy == POLICY_HRRN) {                  // response ratio changes with time: scan
+        if(s->q_size == 0) return -1;
+        int best = 0;
+        float max_hrrn = -1.0;
+        for(int k = 0; k < s->q_size; k++) {
+            PROCESS *p = &s->process[s->queue[(s->q_front+k)%s->capacity]];
+            float wait = (float)(s->curr_time - p->arrive_time);
+            float hrrn = 1+ (float)(wait / p->burst_time);
+            if(hrrn > max_hrrn || (hrrn == max_hrrn &&
+               schedulerTieLess(s, s->queue[(s->q_front+k)%s->capacity], s->queue[(s->q_front+best)%s->capacity]))) {
+                best = k;
+                max_hrrn = hrrn;
+            }
+        }
+        int idx = s->queue[(s->q_front+best)%s->capacity];
+        s->queue[(s->q_front+best)%s->capacity] = s->queue[s->q_front];
+        s->q_front = (s->q_front+1)%s->capacity;
+        s->q_size--;
+        return idx;
+    }
+
+    return heapPop(&s->ready);
+}
+
+void schedulerAdvance(SCHEDULER *s, SCHED_TIME time) {
+    /*
+        INTRODUCTION:
+            Extends the schedule of an online scheduler up to a point in time.
+
+        INPUT PARAMETERS:
+            - s (SCHEDULER*): scheduler.
+            - time (SCHED_TIME): time to advance to (decisions at exactly this time are taken on the next call,
+                          so processes arriving at this time may still be submitted).
+
+        OUTPUT PARAMETERS:
+            - Appends finished GANTT entries and fills wait and turnaround times of completed processes.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Jump from event to event instead of stepping one time unit at a time:
+              arrivals, completions, expiry of a time slice and, for LRTF, the time at which
+              the running process stops having the longest remaining time.
+            - On an event admit arrived processes and let the algorithm decide who runs,
+              each decision costs O(log n) on the ready heap (O(n) for HRRN, whose key changes with time).
+            - Processes submitted at curr_time after the last call are admitted first: they may preempt
+              the running process, and a time slice that expired at curr_time is requeued after them.
+            - The schedule is the same as the one getGantt* builds from all processes at once, also when
+              every process is submitted only once the scheduler has reached its arrival.
+            - Advancing to t1 then to t2 gives the same schedule as advancing to t2 directly.
+    */
+
+    if(!s) return;
+
+    int preemptive = (s->policy == POLICY_SRTF || s->policy == POLICY_PRIORITY_PREEMPTIVE || s->policy == POLICY_LRTF);
+
+    while(s->curr_time < time) {
+        schedulerAdmit(s);
+
+        if(preemptive && s->running != -1 && s->ready.size > 0 &&       // submitted at curr_time after the last call
+           schedulerReadyLess(s, s->ready.data[0], s->running)) {
+            schedulerEmit(s, s->process[s->running].pid, s->run_start, s->curr_time);
+            heapPush(&s->ready, s->running);
+            s->running = -1;
+        }
+
+        if(s->running == -1) {
+            int idx = schedulerPick(s);
+
+            if(idx == -1) {                         // system is IDLE
+                if(s->idle_since == -1) s->idle_since = s->curr_time;
+                if(s->pending.size > 0 && eventNextTime(&s->pending) < time)
+                    s->curr_time = eventNextTime(&s->pending);
+                else
+                    s->curr_time = time;
+                continue;
+            }
+
+            if(s->idle_since != -1) {
+                schedulerEmit(s, -1, s->idle_since, s->curr_time);
+                s->idle_since = -1;
+            }
+            s->running = idx;
+            s->run_start = s->curr_time;
+            s->slice_end = s->curr_time + s->time_slice;
+        }
+
+        PROCESS *p = &s->process[s->running];
+        SCHED_TIME stop = s->curr_time + p->burst_time;     // completion
+
+        if(s->policy == POLICY_ROUND_ROBIN && s->slice_end < stop) stop = s->slice_end;
+
+        if(preemptive && s->pending.size > 0 && eventNextTime(&s->pending) < stop)
+            stop = eventNextTime(&s->pending);
+
+        if(s->policy == POLICY_LRTF && s->ready.size > 0) {      // when does the running process get overtaken?
+            int top = s->ready.data[0];
+            SCHED_TIME steps = p->burst_time - s->process[top].burst_time;
+            if(schedulerTieLess(s, s->running, top)) steps++;
+            if(steps < 1) steps = 1;
+            if(s->curr_time + steps < stop) stop = s->curr_time + steps;
+        }
+
+        if(stop > time || (stop == time && s->policy == POLICY_ROUND_ROBIN && p->burst_time > stop - s->curr_time)) {
+            p->burst_time -= time - s->curr_time;   // run until the requested time only, a slice expiring
+            s->curr_time = time;                    // at time is requeued on the next call, after the
+            break;                                  // processes submitted at time
+        }
+
+        p->burst_time -= stop - s->curr_time;
+        s->curr_time = stop;
+
+        if(p->burst_time == 0) {                    // completed
+            schedulerEmit(s, p->pid, s->run_start, s->curr_time);
+            p->turnaround_time = s->curr_time - p->arrive_time;
+            p->wait_time = p->turnaround_time - p->initial_burst;
+            s->completed++;
+            s->running = -1;
+            continue;
+        }
+
+        if(s->policy == POLICY_ROUND_ROBIN) {       // time slice expired
+            schedulerAdmit(s);
+            schedulerEmit(s, p->pid, s->run_start, s->curr_time);
+            s->queue[(s->q_front+s->q_size)%s->capacity] = s->running;
+            s->q_size++;
+            s->running = -1;
+            continue;
+        }
+
+        if(preemptive) {                            // arrival or LRTF overtake: preempt if needed
+            schedulerAdmit(s);
+            if(s->ready.size > 0 && schedulerReadyLess(s, s->ready.data[0], s->running)) {
+                schedulerEmit(s, p->pid, s->run_start, s->curr_time);
+                heapPush(&s->ready, s->running);
+                s->running = -1;
+            }
+        }
+    }
+}
+
+void schedulerAdvanceTo(SCHEDULER *s, SCHED_TIME time) {
+    /*
+        INTRODUCTION:
+            Extends the schedule of an online scheduler up to a point in time, writing checkpoints on the way.
+
+        INPUT PARAMETERS:
+            - s (SCHEDULER*): scheduler.
+            - time (SCHED_TIME): time to advance to (decisions at exactly this time are taken on the next call,
+                          so processes arriving at this time may still be submitted).
+
+        OUTPUT PARAMETERS:
+            - Appends finished GANTT entries and fills wait and turnaround times of completed processes.
+            - Replaces the checkpoint file at every checkpoint time up to time.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Advance to every checkpoint time in turn and save there (schedulerAdvance), then to time.
+    */
+
+    if(!s) return;
+
+    while(s->checkpoint && s->next_checkpoint <= time) {
+        schedulerAdvance(s, s->next_checkpoint);
+        schedulerSave(s, s->checkpoint);
+        s->next_checkpoint += s->checkpoint_interval;
+    }
+    schedulerAdvance(s, time);
+}
+
+GANTT* schedulerPollSegments(SCHEDULER *s) {
+    /*
+        INTRODUCTION:
+            Returns the GANTT entries finished since the last poll.
+
+        INPUT PARAMETERS:
+            - s (SCHEDULER*): scheduler.
+
+        OUTPUT PARAMETERS:
+            - Detaches the entries from the scheduler.
+
+        RETURN VALUES:
+            - (GANTT*): head of the finished entries (to be freed with destroyGantt), NULL if none.
+
+        APPROACH:
+            - An entry is finished once its process stops running (or the IDLE time ends).
+            - Hand over the linked list and start a new one.
+    */
+
+    if(!s) return NULL;
+    GANTT *ghead = s->ghead;
+    for(GANTT *g = ghead; g; g = g->next) s->polled++;
+    s->ghead = s->gcurr = NULL;
+    return ghead;
+}
+
+int ckptWrite(FILE *fptr, const void *data, size_t bytes) {
+    // Writes a block of a checkpoint, 1 if successful
+    return fwrite(data, 1, bytes, fptr) == bytes;
+}
+
+int ckptRead(FILE *fptr, void *data, size_t bytes) {
+    // Reads a block of a checkpoint, 1 if successful
+    return fread(data, 1, bytes, fptr) == bytes;
+}
+
+int schedulerSaveFile(SCHEDULER *s, FILE *fptr) {
+    /*
+        INTRODUCTION:
+            Writes the state of an online scheduler to an open binary file.
+
+        INPUT PARAMETERS:
+            - s (SCHEDULER*): scheduler.
+            - fptr (FILE*): file opened for binary writing.
+
+        OUTPUT PARAMETERS:
+            - Writes the checkpoint at the position of fptr.
+
+        RETURN VALUES:
+            - (int): 0 if successful, -1 if any error.
+
+        APPROACH:
+            - Header: CHECKPOINT_MAGIC, then the sizes of SCHED_TIME and PROCESS (a checkpoint is only
+              read back by a build with the same layout).
+            - Clock, running process, counters and output position, then the processes (remaining
+              bursts, wait and turnaround times), the indices in the pending queue, the ready heap and
+              the circular queue, and the GANTT entries that have not been polled yet.
+            - The event queue is stored as its indices only, its events are arrival times.
+    */
+
+    if(!s || !fptr) return -1;
+
+    int count = s->pending.size;
+    int *idx = (int *)malloc((count > 0 ? count : 1)*sizeof(int));
+    eventQueued(&s->pending, idx);
+
+    long long entries = 0;
+    for(GANTT *g = s->ghead; g; g = g->next) entries++;
+
+    int header[4] = {(int)sizeof(SCHED_TIME), (int)sizeof(PROCESS), (int)s->policy, (int)s->pending.kind};
+    SCHED_TIME times[6] = {s->time_slice, s->curr_time, s->run_start, s->slice_end, s->idle_since, s->pending.now};
+    int counts[6] = {s->n, s->completed, s->running, count, s->ready.size, s->q_size};
+
+    int ok = ckptWrite(fptr, CHECKPOINT_MAGIC, 8) && ckptWrite(fptr, header, sizeof(header)) &&
+             ckptWrite(fptr, times, sizeof(times)) && ckptWrite(fptr, counts, sizeof(counts)) &&
+             ckptWrite(fptr, &s->polled, sizeof(long long)) && ckptWrite(fptr, &s->output_offset, sizeof(long long)) &&
+             ckptWrite(fptr, s->process, s->n*sizeof(PROCESS)) && ckptWrite(fptr, idx, count*sizeof(int)) &&
+             ckptWrite(fptr, s->ready.data, s->ready.size*sizeof(int));
+    for(int k = 0; ok && k < s->q_size; k++)
+        ok = ckptWrite(fptr, &s->queue[(s->q_front+k)%s->capacity], sizeof(int));
+    ok = ok && ckptWrite(fptr, &entries, sizeof(long long));
+    for(GANTT *g = s->ghead; ok && g; g = g->next)
+        ok = ckptWrite(fptr, &g->pid, sizeof(int)) && ckptWrite(fptr, &g->start_time, sizeof(SCHED_TIME)) &&
+             ckptWrite(fptr, &g->finish_time, sizeof(SCHED_TIME));
+
+    free(idx);
+    if(!ok) {
+        printf("\nFailed to write the checkpoint!\n");
+        return -1;
+    }
+    return 0;
+}
+
+SCHEDULER* schedulerLoadFile(FILE *fptr) {
+    /*
+        INTRODUCTION:
+            Restores an online scheduler from a checkpoint written by schedulerSaveFile.
+
+        INPUT PARAMETERS:
+            - fptr (FILE*): file opened for binary reading.
+
+        OUTPUT PARAMETERS:
+            - None.
+
+        RETURN VALUES:
+            - (SCHEDULER*): the restored scheduler, NULL if any error.
+
+        APPROACH:
+            - Check the header, create a scheduler and fill it, checking every index.
+            - Queued events and ready processes are pushed again: they are taken out in a total order
+              (time or key, then tie breaker), so the rest of the schedule is the same as without
+              the checkpoint. Automatic checkpoints are off until schedulerSetCheckpoint is called.
+    */
+
+    char magic[8];
+    int header[4], counts[6];
+    SCHED_TIME times[6];
+
+    if(!fptr || !ckptRead(fptr, magic, 8) || memcmp(magic, CHECKPOINT_MAGIC, 8) != 0 ||
+       !ckptRead(fptr, header, sizeof(header)) || header[0] != (int)sizeof(SCHED_TIME) || header[1] != (int)sizeof(PROCESS) ||
+       header[2] < 0 || header[2] >= POLICY_COUNT || header[3] < EVENTQ_AUTO || header[3] > EVENTQ_WHEEL ||
+       !ckptRead(fptr, times, sizeof(times)) || !ckptRead(fptr, counts, sizeof(counts))) {
+        printf("\nInvalid checkpoint file!\n");
+        return NULL;
+    }
+
+    int n = counts[0];
+    if(n < 0 || counts[1] < 0 || counts[1] > n || counts[2] < -1 || counts[2] >= n || counts[3] < 0 || counts[3] > n ||
+       counts[4] < 0 || counts[4] > n || counts[5] < 0 || counts[5] > n) {
+        printf("\nInvalid checkpoint file!\n");
+        return NULL;
+    }
+
+    SCHEDULER *s = createScheduler((SCHED_POLICY)header[2], times[0]);
+    if(!s) return NULL;
+    schedulerUseEventQueue(s, (EVENTQ_KIND)header[3]);
+
+    while(s->capacity < n) s->capacity *= 2;
+    s->process = (PROCESS *)realloc(s->process, s->capacity*sizeof(PROCESS));
+    s->queue = (int *)realloc(s->queue, s->capacity*sizeof(int));
+
+    int *idx = (int *)malloc((n > 0 ? n : 1)*sizeof(int));
+    long long entries = 0;
+    int ok = ckptRead(fptr, &s->polled, sizeof(long long)) && ckptRead(fptr, &s->output_offset, sizeof(long long)) &&
+             ckptRead(fptr, s->process, n*sizeof(PROCESS));
+
+    s->n = n;
+    s->pending.now = times[5];
+    if(ok && (ok = ckptRead(fptr, idx, counts[3]*sizeof(int))))
+        for(int k = 0; ok && k < counts[3]; k++)
+            ok = idx[k] >= 0 && idx[k] < n && eventPush(&s->pending, idx[k], s->process[idx[k]].arrive_time) == 0;
+    if(ok && (ok = ckptRead(fptr, idx, counts[4]*sizeof(int))))
+        for(int k = 0; ok && k < counts[4]; k++) {
+            ok = idx[k] >= 0 && idx[k] < n;
+            if(ok) heapPush(&s->ready, idx[k]);
+        }
+    if(ok && (ok = ckptRead(fptr, s->queue, counts[5]*sizeof(int))))
+        for(int k = 0; ok && k < counts[5]; k++) ok = s->queue[k] >= 0 && s->queue[k] < n;
+    ok = ok && ckptRead(fptr, &entries, sizeof(long long)) && entries >= 0;
+
+    for(long long e = 0; ok && e < entries; e++) {
+        GANTT *gnew = ganttAlloc();
+        gnew->next = NULL;
+        ok = ckptRead(fptr, &gnew->pid, sizeof(int)) && ckptRead(fptr, &gnew->start_time, sizeof(SCHED_TIME)) &&
+             ckptRead(fptr, &gnew->finish_time, sizeof(SCHED_TIME));
+        if(!s->ghead) s->ghead = s->gcurr = gnew;
+        else {
+            s->gcurr->next = gnew;
+            s->gcurr = gnew;
+        }
+    }
+    free(idx);
+
+    if(!ok) {
+        printf("\nInvalid checkpoint file!\n");
+        destroyScheduler(s);
+        return NULL;
+    }
+
+    s->curr_time = times[1];
+    s->run_start = times[2];
+    s->slice_end = times[3];
+    s->idle_since = times[4];
+    s->completed = counts[1];
+    s->running = counts[2];
+    s->q_front = 0;
+    s->q_size = counts[5];
+    return s;
+}
+
+int schedulerSave(SCHEDULER *s, char *fileName) {
+    /*
+        INTRODUCTION:
+            Writes a checkpoint of an online scheduler to a file.
+
+        INPUT PARAMETERS:
+            - s (SCHEDULER*): scheduler.
+            - fileName (char*): path to the checkpoint.
+
+        OUTPUT PARAMETERS:
+            - Replaces the file.
+
+        RETURN VALUES:
+            - (int): 0 if successful, -1 if any error.
+
+        APPROACH:
+            - Write to fileName.tmp, sync it to disk and rename it over fileName, so an interrupted
+              write or a crash never destroys the previous checkpoint.
+    */
+
+    if(!s || !fileName) return -1;
+
+    size_t len = strlen(fileName);
+    char *tmp = (char *)malloc(len + 5);
+    memcpy(tmp, fileName, len);
+    memcpy(tmp + len, ".tmp", 5);
+
+    FILE *fptr = fopen(tmp, "wb");
+    if(!fptr) {
+        printf("\nFailed to open the file!\n");
+        free(tmp);
+        return -1;
+    }
+    int ok = (schedulerSaveFile(s, fptr) == 0);
+    ok = ok && fflush(fptr) == 0 && fsync(fileno(fptr)) == 0;     // on disk before it replaces the old one
+    ok = (fclose(fptr) == 0) && ok;
+    ok = ok && (rename(tmp, fileName) == 0);
+    if(!ok) remove(tmp);
+    free(tmp);
+    return ok ? 0 : -1;
+}
+
+SCHEDULER* schedulerLoad(char *fileName) {
+    /*
+        INTRODUCTION:
+            Restores an online scheduler from a checkpoint file written by schedulerSave.
+
+        INPUT PARAMETERS:
+            - fileName (char*): path to the checkpoint.
+
+        RETURN VALUES:
+            - (SCHEDULER*): the restored scheduler, NULL if any error.
+    */
+
+    FILE *fptr = fopen(fileName, "rb");
+    if(!fptr) {
+        printf("\nFailed to open the file!\n");
+        return NULL;
+    }
+    SCHEDULER *s = schedulerLoadFile(fptr);
+    fclose(fptr);
+    return s;
+}
+
+int schedulerSetCheckpoint(SCHEDULER *s, char *fileName, SCHED_TIME interval) {
+    /*
+        INTRODUCTION:
+            Makes schedulerAdvanceTo write a checkpoint every interval time units.
+
+        INPUT PARAMETERS:
+            - s (SCHEDULER*): scheduler.
+            - fileName (char*): path to the checkpoint (NULL or interval <= 0: no checkpoints).
+            - interval (SCHED_TIME): time between two checkpoints.
+
+        OUTPUT PARAMETERS:
+            - Stores a copy of the path in the scheduler.
+
+        RETURN VALUES:
+            - (int): 0 if successful, -1 if any error.
+
+        APPROACH:
+            - Checkpoints are taken at multiples of interval, so a resumed run takes them at the
+              same times as an uninterrupted one.
+    */
+
+    if(!s) return -1;
+    free(s->checkpoint);
+    s->checkpoint = NULL;
+    s->checkpoint_interval = 0;
+    if(!fileName || interval <= 0) return 0;
+
+    s->checkpoint = (char *)malloc(strlen(fileName) + 1);
+    strcpy(s->checkpoint, fileName);
+    s->checkpoint_interval = interval;
+    s->next_checkpoint = (s->curr_time / interval + 1) * interval;
+    return 0;
+}
+
+void destroyScheduler(SCHEDULER *s) {
+    /*
+        INTRODUCTION:
+            Frees allocated memory of an online scheduler.
+
+        INPUT PARAMETERS:
+            - s (SCHEDULER*): scheduler.
+
+        OUTPUT PARAMETERS:
+            - Frees dynamically allocated memory.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Free unpolled GANTT entries, event queue, heap, queue, process array, checkpoint path and the structure.
+    */
+
+    if(!s) return;
+    destroyGantt(s->ghead);
+    free(s->checkpoint);
+    eventDestroy(&s->pending);
+    heapDestroy(&s->ready);
+    free(s->queue);
+    free(s->process);
+    free(s);
+}
+
+int getProcessesFileGroups(char *fileName, PROCESS **process, int **group, CGROUP **groups, int *n_groups) {
+    /*
+        INTRODUCTION:
+            Reads control groups and the processes that belong to them from a file.
+
+        INPUT PARAMETERS:
+            - fileName (char*): path to file.
+            - process (PROCESS**): pointer to array of PROCESS structs (to be allocated).
+            - group (int**): pointer to the group of every process (to be allocated).
+            - groups (CGROUP**): pointer to array of CGROUP structs (to be allocated).
+            - n_groups (int*): receives the number of groups.
+
+        OUTPUT PARAMETERS:
+            - Allocates and fills *process, *group and *groups.
+
+        RETURN VALUES:
+            - (int): number of processes read from file, -1 if any error.
+
+        APPROACH:
+            - Open file.
+            - Read the number of groups, then for every group its parent (-1 for none, else an
+              earlier group), shares, quota and period (quota 0 = no limit, then period is ignored).
+            - Read the number of processes, then for every process its arrival time, burst time and group,
+              which must be a group without subgroups.
+            - Close file.
+    */
+
+    *process = NULL;
+    *group = NULL;
+    *groups = NULL;
+    *n_groups = 0;
+
+    FILE *fptr = fopen(fileName, "r");
+    if(!fptr) {
+        printf("\nFailed to open the file!\n");
+        return -1;
+    }
+
+    int g = 0;
+    fscanf(fptr, "%d", &g);
+    if(g < 1) {
+        printf("\nInvalid number of groups!\n");
+        fclose(fptr);
+        return -1;
+    }
+
+    CGROUP *cg = (CGROUP *)calloc(g, sizeof(CGROUP));
+    for(int k = 0; k < g; ++k) {
+        int check_parent = -2, check_shares = 0;
+        SCHED_TIME check_quota = -1, check_period = -1;
+
+        if(fscanf(fptr, "%d %d " TIME_FMT " " TIME_FMT, &check_parent, &check_shares, &check_quota, &check_period) != 4) {
+            printf("\nIncomplete data in the file at group %d!\n", k);
+            fclose(fptr);
+            free(cg);
+            return -1;
+        }
+        if(check_parent < -1 || check_parent >= k || check_shares < 1 || check_quota < 0 ||
+           (check_quota > 0 && check_period < 1)) {
+            printf("\nInvalid value for parent/shares/quota/period at group %d!\n", k);
+            fclose(fptr);
+            free(cg);
+            return -1;
+        }
+
+        cg[k].parent = check_parent;
+        cg[k].shares = check_shares;
+        cg[k].quota = check_quota;
+        cg[k].period = (check_quota > 0) ? check_period : 0;
+        if(check_parent != -1) cg[check_parent].children++;
+    }
+
+    int n = 0;
+    fscanf(fptr, "%d", &n);
+    if(n < 1) {
+        printf("\nInvalid number of processes!\n");
+        fclose(fptr);
+        free(cg);
+        return -1;
+    }
+
+    PROCESS *p = (PROCESS *)malloc(n*sizeof(PROCESS));
+    int *member = (int *)malloc(n*sizeof(int));
+
+    for(int i = 0; i < n; ++i) {
+        SCHED_TIME check_at = -1, check_bt = -1;
+        int check_g = -1;
+
+        if(fscanf(fptr, TIME_FMT " " TIME_FMT " %d", &check_at, &check_bt, &check_g) != 3) {
+            printf("\nIncomplete data in the file at process %d!\n", i);
+            fclose(fptr);
+            free(cg);
+            free(p);
+            free(member);
+            return -1;
+        }
+        if(check_at < 0 || check_bt < 1 || check_g < 0 || check_g >= g || cg[check_g].children > 0) {
+            printf("\nInvalid value for arrival/burst time/group at process %d!\n", i);
+            fclose(fptr);
+            free(cg);
+            free(p);
+            free(member);
+            return -1;
+        }
+
+        p[i].pid = i;
+        p[i].arrive_time = check_at;
+        p[i].burst_time = p[i].initial_burst = check_bt;
+        p[i].priority = -1;
+        member[i] = check_g;
+    }
+    fclose(fptr);
+
+    *process = p;
+    *group = member;
+    *groups = cg;
+    *n_groups = g;
+    return n;
+}
+
+int eventIndexLess(void *ctx, int a, int b) {
+    // Events at the same time: lower index first
+    (void)ctx;
+    return a < b;
+}
+
+void cgroupEnqueue(CGROUP *groups, int *next, int *group, int idx) {
+    // Appends a runnable process to the FIFO of its group
+    CGROUP *c = &groups[group[idx]];
+    next[idx] = -1;
+    if(c->head == -1) c->head = idx;
+    else next[c->tail] = idx;
+    c->tail = idx;
+}
+
+int cgroupLess(void *ctx, int a, int b) {
+    // Run queue ordering of sibling groups: vruntime, then index
+    CGROUP *groups = (CGROUP *)ctx;
+    if(groups[a].vruntime != groups[b].vruntime) return groups[a].vruntime < groups[b].vruntime;
+    return a < b;
+}
+
+void cgroupRequeue(CGROUP *groups, int g, HEAP *root, double *root_min) {
+    /*
+        INTRODUCTION:
+            Puts a group, and then its ancestors, back in the run queue of their parent if they have work.
+
+        INPUT PARAMETERS:
+            - groups (CGROUP*): groups.
+            - g (int): group whose run queue changed.
+            - root (HEAP*): run queue of the top level groups.
+            - root_min (double*): min_vruntime of the top level.
+
+        OUTPUT PARAMETERS:
+            - Modifies the run queues.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Stop at the first group that is queued already, throttled or has no runnable process
+              or subgroup: its ancestors are unchanged.
+            - A group that was not queued may have slept for a while, it restarts at the min_vruntime
+              of its parent so it does not take the CPU back for all the time it was away.
+    */
+
+    while(g != -1) {
+        CGROUP *c = &groups[g];
+        if(c->queued || c->throttled || (c->head == -1 && c->heap.size == 0)) return;
+
+        double floor = (c->parent == -1) ? *root_min : groups[c->parent].min_vruntime;
+        if(c->vruntime < floor) c->vruntime = floor;
+        heapPush((c->parent == -1) ? root : &groups[c->parent].heap, g);
+        c->queued = 1;
+        g = c->parent;
+    }
+}
+
+GANTT* getGanttGroups(PROCESS *process, int n, int *group, CGROUP *groups, int n_groups, SCHED_TIME time_slice) {
+    /*
+        INTRODUCTION:
+            Simulates hierarchical weighted fair-share scheduling of processes in control groups,
+            with CPU bandwidth quotas.
+
+        INPUT PARAMETERS:
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+            - group (int*): group of every process (a group without subgroups).
+            - groups (CGROUP*): groups.
+            - n_groups (int): number of groups.
+            - time_slice (SCHED_TIME): longest time a process runs before the next decision.
+
+        OUTPUT PARAMETERS:
+            - Constructs GANTT chart linked list.
+            - Fills wait and turnaround times of the processes, and the usage and throttling
+              statistics of the groups.
+
+        RETURN VALUES:
+            - (GANTT*): pointer to GANTT chart head.
+
+        APPROACH:
+            - Every group has its own run queue: a FIFO of its runnable processes, or a heap of its
+              runnable subgroups ordered on vruntime. A decision walks down from the top level,
+              picking the subgroup with the smallest vruntime at every level, then the first process
+              of the group reached: O(depth * log(siblings)), whatever the number of groups.
+            - The process runs for the time slice, or less if it completes, or if a group on its path
+              uses up its quota or reaches the end of its period. The run adds to the usage of every
+              group on the path, and to its vruntime in proportion to CGROUP_DEFAULT_SHARES / shares.
+            - A group that uses up its quota before the end of the period is throttled: it leaves the
+              run queue of its parent until the next period starts, then gets its full quota back.
+            - Arrivals and ends of throttling are events of two EVENT_QUEUEs; the CPU is IDLE when no
+              process is runnable in a group that is not throttled.
+            - Arrivals at the end of a time slice are queued before the preempted process, as in
+              Round Robin.
+    */
+
+    if(n < 1 || !process || !group || !groups || n_groups < 1) {
+        printf("\nInvalid number of Processes!\n");
+        return NULL;
+    }
+    if(time_slice <= 0) {
+        printf("\nInvalid value of Time Slice!\n");
+        return NULL;
+    }
+
+    for(int k = 0; k < n_groups; k++) {
+        CGROUP *c = &groups[k];
+        c->usage = c->throttled_time = c->wait_time = 0;
+        c->nr_throttled = c->completed = 0;
+        c->vruntime = c->min_vruntime = 0;
+        c->runtime_left = c->quota;
+        c->period_index = 0;
+        c->throttled = c->queued = 0;
+        c->head = c->tail = -1;
+        heapInit(&c->heap, cgroupLess, groups);
+    }
+
+    HEAP root;
+    heapInit(&root, cgroupLess, groups);
+    double root_min = 0;
+
+    EVENT_QUEUE arrivals, unthrottle;
+    eventInit(&arrivals, EVENTQ_AUTO, eventIndexLess, NULL);
+    eventInit(&unthrottle, EVENTQ_AUTO, eventIndexLess, NULL);
+
+    int *next = (int *)malloc(n*sizeof(int));
+    int *path = (int *)malloc(n_groups*sizeof(int));
+    for(int i = 0; i < n; i++) {
+        process[i].burst_time = process[i].initial_burst;
+        process[i].wait_time = process[i].turnaround_time = 0;
+        eventPush(&arrivals, i, process[i].arrive_time);
+    }
+
+    int completed = 0;
+    SCHED_TIME curr_time = 0;
+    GANTT *ghead = NULL, *gcurr = NULL;
+
+    while(completed < n) {
+        while(arrivals.size > 0 && eventNextTime(&arrivals) <= curr_time) {
+            int idx = eventPop(&arrivals);
+            cgroupEnqueue(groups, next, group, idx);
+            cgroupRequeue(groups, group[idx], &root, &root_min);
+        }
+        while(unthrottle.size > 0 && eventNextTime(&unthrottle) <= curr_time) {
+            SCHED_TIME at = eventNextTime(&unthrottle);
+            int g = eventPop(&unthrottle);
+            CGROUP *c = &groups[g];
+            c->throttled = 0;
+            c->throttled_time += at - c->throttle_start;
+            c->runtime_left = c->quota;
+            c->period_index = at / c->period;
+            cgroupRequeue(groups, g, &root, &root_min);
+        }
+
+        if(root.size == 0) {                        // IDLE until the next arrival or end of throttling
+            SCHED_TIME wake = eventNextTime(&arrivals);
+            if(eventNextTime(&unthrottle) < wake) wake = eventNextTime(&unthrottle);
+            appendGantt(&ghead, &gcurr, -1, curr_time, wake);
+            curr_time = wake;
+            continue;
+        }
+
+        int depth = 0, g = heapPop(&root);          // walk down to a process
+        if(groups[g].vruntime > root_min) root_min = groups[g].vruntime;
+        while(1) {
+            CGROUP *c = &groups[g];
+            c->queued = 0;
+            path[depth++] = g;
+            if(c->head != -1) break;
+            int child = heapPop(&c->heap);
+            if(groups[child].vruntime > c->min_vruntime) c->min_vruntime = groups[child].vruntime;
+            g = child;
+        }
+
+        CGROUP *leaf = &groups[g];
+        int idx = leaf->head;
+        leaf->head = next[idx];
+        if(leaf->head == -1) leaf->tail = -1;
+
+        SCHED_TIME run = (process[idx].burst_time < time_slice) ? process[idx].burst_time : time_slice;
+        for(int k = 0; k < depth; k++) {           // quotas of the path, refilled at every new period
+            CGROUP *c = &groups[path[k]];
+            if(c->quota == 0) continue;
+            if(curr_time / c->period != c->period_index) {
+                c->period_index = curr_time / c->period;
+                c->runtime_left = c->quota;
+            }
+            SCHED_TIME period_end = (c->period_index + 1) * c->period;
+            if(c->runtime_left < run) run = c->runtime_left;
+            if(period_end - curr_time < run) run = period_end - curr_time;
+        }
+
+        appendGantt(&ghead, &gcurr, process[idx].pid, curr_time, curr_time + run);
+        curr_time += run;
+        process[idx].burst_time -= run;
+
+        for(int k = 0; k < depth; k++) {
+            CGROUP *c = &groups[path[k]];
+            c->usage += run;
+            c->vruntime += (double)run * CGROUP_DEFAULT_SHARES / c->shares;
+            if(c->quota == 0) continue;
+            c->runtime_left -= run;
+            SCHED_TIME period_end = (c->period_index + 1) * c->period;
+            if(c->runtime_left == 0 && curr_time < period_end) {       // throttled until the next period
+                c->throttled = 1;
+                c->throttle_start = curr_time;
+                c->nr_throttled++;
+                eventPush(&unthrottle, path[k], period_end);
+            }
+        }
+
+        while(arrivals.size > 0 && eventNextTime(&arrivals) <= curr_time) {
+            int a = eventPop(&arrivals);
+            cgroupEnqueue(groups, next, group, a);
+            cgroupRequeue(groups, group[a], &root, &root_min);
+        }
+
+        if(process[idx].burst_time == 0) {          // completed
+            process[idx].turnaround_time = curr_time - process[idx].arrive_time;
+            process[idx].wait_time = process[idx].turnaround_time - process[idx].initial_burst;
+            completed++;
+            for(int k = 0; k < depth; k++) {
+                groups[path[k]].completed++;
+                groups[path[k]].wait_time += process[idx].wait_time;
+            }
+        }
+        else cgroupEnqueue(groups, next, group, idx);      // back to the end of its group's FIFO
+
+        for(int k = depth-1; k >= 0; k--) cgroupRequeue(groups, path[k], &root, &root_min);
+    }
+
+    for(int k = 0; k < n_groups; k++) heapDestroy(&groups[k].heap);
+    heapDestroy(&root);
+    eventDestroy(&arrivals);
+    eventDestroy(&unthrottle);
+    free(next);
+    free(path);
+    return ghead;
+}
+
+void displayGroups(CGROUP *groups, int n_groups, GANTT *gantt) {
+    /*
+        INTRODUCTION:
+            Displays the CPU usage and throttling of every control group after getGanttGroups.
+
+        INPUT PARAMETERS:
+            - groups (CGROUP*): groups.
+            - n_groups (int): number of groups.
+            - gantt (GANTT*): GANTT chart of the run.
+
+        OUTPUT PARAMETERS:
+            - Prints the group table to console.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Utilization is the usage of the group (with its subgroups) over the length of the chart.
+            - Average wait is over the completed processes of the group and its subgroups.
+    */
+
+    if(!groups || !gantt) {
+        printf("\nCannot display groups!\n");
+        return;
+    }
+
+    SCHED_TIME total = 0;
+    for(GANTT *g = gantt; g; g = g->next) total = g->finish_time;
+    if(total == 0) total = 1;
+
+    printf("\n\nControl groups:-");
+    printf("\nGroup\tParent\tShares\tQuota\tPeriod\tUsage\tCPU%%\tThrottled\tPeriods\tAvgWait");
+    printf("\n--------------------------------------------------------------------------------------");
+    for(int k = 0; k < n_groups; k++) {
+        CGROUP *c = &groups[k];
+        printf("\n%d\t%d\t%d\t" TIME_FMT "\t" TIME_FMT "\t" TIME_FMT "\t%.1f\t" TIME_FMT "\t\t%d\t%.2f",
+            k, c->parent, c->shares, c->quota, c->period, c->usage, 100.0*c->usage/total,
+            c->throttled_time, c->nr_throttled, c->completed ? (double)c->wait_time/c->completed : 0.0);
+    }
+    printf("\n--------------------------------------------------------------------------------------\n");
+}
+
+void destroyGroups(CGROUP *groups) {
+    // Frees allocated memory of a CGROUP array (run queues are freed by getGanttGroups)
+    if(groups) free(groups);
+}
+
+int getCoresFile(char *fileName, CPU_CORE **core) {
+    /*
+        INTRODUCTION:
+            Reads the cores of a heterogeneous multiprocessor from a file.
+
+        INPUT PARAMETERS:
+            - fileName (char*): path to file.
+            - core (CPU_CORE**): pointer to array of CPU_CORE structs (to be allocated).
+
+        OUTPUT PARAMETERS:
+            - Allocates and fills *core.
+
+        RETURN VALUES:
+            - (int): number of cores read from file, -1 if any error.
+
+        APPROACH:
+            - Open file.
+            - Read number of cores, then the speed and busy power of every core, both must be positive.
+            - Close file.
+    */
+
+    *core = NULL;
+    FILE *fptr = fopen(fileName, "r");
+    if(!fptr) {
+        printf("\nFailed to open the file!\n");
+        return -1;
+    }
+
+    int n = 0;
+    fscanf(fptr, "%d", &n);
+    if(n < 1) {
+        printf("\nInvalid number of cores!\n");
+        fclose(fptr);
+        return -1;
+    }
+
+    *core = (CPU_CORE *)calloc(n, sizeof(CPU_CORE));
+    for(int c = 0; c < n; ++c) {
+        double check_speed = -1, check_power = -1;
+
+        if(fscanf(fptr, "%lf %lf", &check_speed, &check_power) != 2 || check_speed <= 0 || check_power <= 0) {
+            printf("\nInvalid value for speed/power at core %d!\n", c);
+            fclose(fptr);
+            free(*core);
+            *core = NULL;
+            return -1;
+        }
+        (*core)[c].speed = check_speed;
+        (*core)[c].power = check_power;
+    }
+    fclose(fptr);
+    return n;
+}
+
+SCHED_TIME coreWallTime(SCHED_TIME work, double speed) {
+    // Time a burst of work takes at speed, rounded up to a whole time unit (at least 1 unless there is no work)
+    if(work <= 0) return 0;
+    SCHED_TIME wall = (SCHED_TIME)(work / speed);
+    if(wall * speed < work - 1e-9) wall++;
+    return (wall < 1) ? 1 : wall;
+}
+
+int placeProcess(CPU_CORE *core, int n_cores, SCHED_TIME *busy_until, SCHED_TIME arrive_time, SCHED_TIME work,
+                 PLACEMENT placement) {
+    /*
+        INTRODUCTION:
+            Chooses the core of an arriving process.
+
+        INPUT PARAMETERS:
+            - core (CPU_CORE*): cores.
+            - n_cores (int): number of cores.
+            - busy_until (SCHED_TIME*): time at which every core runs out of work placed so far.
+            - arrive_time (SCHED_TIME): arrival time of the process.
+            - work (SCHED_TIME): its burst time.
+            - placement (PLACEMENT): placement policy.
+
+        RETURN VALUES:
+            - (int): index of the core.
+
+        APPROACH:
+            - A core is free if it has run out of work by the arrival.
+            - PLACE_FASTEST_FREE: the fastest free core.
+            - PLACE_ENERGY_AWARE: the free core with the least energy per unit of work (power / speed),
+              the faster one if two are equally efficient.
+            - If no core is free, the core on which the process would finish first.
+    */
+
+    int best = -1;
+    for(int c = 0; c < n_cores; c++) {
+        if(busy_until[c] > arrive_time) continue;
+        if(best == -1) {
+            best = c;
+            continue;
+        }
+        if(placement == PLACE_FASTEST_FREE) {
+            if(core[c].speed > core[best].speed) best = c;
+        }
+        else {
+            double e = core[c].power / core[c].speed, e_best = core[best].power / core[best].speed;
+            if(e < e_best || (e == e_best && core[c].speed > core[best].speed)) best = c;
+        }
+    }
+    if(best != -1) return best;
+
+    SCHED_TIME first = TIME_MAX;
+    for(int c = 0; c < n_cores; c++) {
+        SCHED_TIME finish = busy_until[c] + coreWallTime(work, core[c].speed);
+        if(finish < first) {
+            first = finish;
+            best = c;
+        }
+    }
+    return best;
+}
+
+GANTT** getGanttCores(PROCESS *process, int n, SCHED_POLICY policy, SCHED_TIME time_slice, CPU_CORE *core,
+                      int n_cores, PLACEMENT placement, int *placed) {
+    /*
+        INTRODUCTION:
+            Runs a scheduling algorithm on a multiprocessor whose cores have different speeds.
+
+        INPUT PARAMETERS:
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+            - policy (SCHED_POLICY): algorithm every core runs on its own processes.
+            - time_slice (SCHED_TIME): time quantum (only used by Round Robin).
+            - core (CPU_CORE*): cores.
+            - n_cores (int): number of cores.
+            - placement (PLACEMENT): how a core is chosen for an arriving process.
+            - placed (int*): if not NULL, receives the core of every process.
+
+        OUTPUT PARAMETERS:
+            - Fills wait and turnaround times of the processes (wall clock, wait excludes the time
+              the process ran) and the load of every core.
+
+        RETURN VALUES:
+            - (GANTT**): array of n_cores GANTT charts (NULL for a core without processes),
+              to be freed with destroyGanttCores; NULL if any error.
+
+        APPROACH:
+            - Place processes in order of arrival (EVENT_QUEUE), each core has its own run queue
+              like a per-CPU run queue. The time a core runs out of work does not depend on the
+              (work-conserving) algorithm, so placement knows it exactly without simulating.
+            - Every core then runs the unchanged algorithm (getGanttPolicy) on its processes, with
+              their bursts converted to time on that core.
+    */
+
+    if(n < 1 || !process || !core || n_cores < 1) {
+        printf("\nInvalid number of Processes!\n");
+        return NULL;
+    }
+    if(policy < 0 || policy >= POLICY_COUNT) {
+        printf("\nInvalid scheduling algorithm!\n");
+        return NULL;
+    }
+    if(policy == POLICY_ROUND_ROBIN && time_slice <= 0) {
+        printf("\nInvalid value of Time Slice!\n");
+        return NULL;
+    }
+
+    int *where = (int *)malloc(n*sizeof(int));
+    SCHED_TIME *busy_until = (SCHED_TIME *)calloc(n_cores, sizeof(SCHED_TIME));
+    for(int c = 0; c < n_cores; c++) core[c].processes = core[c].work = core[c].busy = core[c].finish = 0;
+
+    EVENT_QUEUE arrivals;
+    eventInit(&arrivals, EVENTQ_AUTO, eventIndexLess, NULL);
+    for(int i = 0; i < n; i++) eventPush(&arrivals, i, process[i].arrive_time);
+    while(arrivals.size > 0) {
+        int i = eventPop(&arrivals);
+        int c = placeProcess(core, n_cores, busy_until, process[i].arrive_time, process[i].initial_burst, placement);
+        SCHED_TIME start = (busy_until[c] > process[i].arrive_time) ? busy_until[c] : process[i].arrive_time;
+        busy_until[c] = start + coreWallTime(process[i].initial_burst, core[c].speed);
+        where[i] = c;
+        core[c].processes++;
+        core[c].work += process[i].initial_burst;
+    }
+    eventDestroy(&arrivals);
+
+    GANTT **gantt = (GANTT **)calloc(n_cores, sizeof(GANTT *));
+    PROCESS *sub = (PROCESS *)malloc(n*sizeof(PROCESS));
+    int *orig = (int *)malloc(n*sizeof(int));
+
+    for(int c = 0; c < n_cores; c++) {
+        int m = 0;
+        for(int i = 0; i < n; i++) {
+            if(where[i] != c) continue;
+            sub[m] = process[i];
+            sub[m].pid = m;                         // position in orig, the real pid is put back below
+            sub[m].burst_time = sub[m].initial_burst = coreWallTime(process[i].initial_burst, core[c].speed);
+            orig[m++] = i;
+        }
+        if(m == 0) continue;
+
+        gantt[c] = getGanttPolicy(policy, sub, m, time_slice);
+        for(GANTT *g = gantt[c]; g; g = g->next) {
+            if(g->pid >= 0) {
+                core[c].busy += g->finish_time - g->start_time;
+                g->pid = process[orig[g->pid]].pid;
+            }
+            core[c].finish = g->finish_time;
+        }
+        for(int k = 0; k < m; k++) {
+            PROCESS *p = &process[orig[sub[k].pid]];
+            p->wait_time = sub[k].wait_time;
+            p->turnaround_time = sub[k].turnaround_time;
+        }
+    }
+
+    if(placed) memcpy(placed, where, n*sizeof(int));
+    free(where);
+    free(busy_until);
+    free(sub);
+    free(orig);
+    return gantt;
+}
+
+void displayCores(CPU_CORE *core, int n_cores, PROCESS *process, PROCESS *baseline, int n) {
+    /*
+        INTRODUCTION:
+            Displays the load of every core after getGanttCores, and how much sooner processes
+            complete than in a baseline run.
+
+        INPUT PARAMETERS:
+            - core (CPU_CORE*): cores.
+            - n_cores (int): number of cores.
+            - process (PROCESS*): processes of the run.
+            - baseline (PROCESS*): the same processes scheduled another way (e.g. on reference cores), may be NULL.
+            - n (int): number of processes.
+
+        OUTPUT PARAMETERS:
+            - Prints the core table and the comparison to console.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Utilization is the busy time of a core over the makespan (last finish of any core).
+            - Completion time is arrival + turnaround time, compared on average and for the last process.
+    */
+
+    if(!core || !process) {
+        printf("\nCannot display cores!\n");
+        return;
+    }
+
+    SCHED_TIME makespan = 0;
+    for(int c = 0; c < n_cores; c++)
+        if(core[c].finish > makespan) makespan = core[c].finish;
+
+    printf("\n\nCores:-");
+    printf("\nCore\tSpeed\tPower\tProcs\tWork\tBusy\tFinish\tLoad%%");
+    printf("\n----------------------------------------------------------------");
+    for(int c = 0; c < n_cores; c++)
+        printf("\n%d\t%.2f\t%.2f\t%d\t" TIME_FMT "\t" TIME_FMT "\t" TIME_FMT "\t%.1f", c, core[c].speed, core[c].power,
+            core[c].processes, core[c].work, core[c].busy, core[c].finish,
+            makespan > 0 ? 100.0*core[c].busy/makespan : 0.0);
+
+    if(baseline) {
+        long long done = 0, done_base = 0;
+        SCHED_TIME last = 0, last_base = 0;
+        for(int i = 0; i < n; i++) {
+            SCHED_TIME t = process[i].arrive_time + process[i].turnaround_time;
+            SCHED_TIME t_base = baseline[i].arrive_time + baseline[i].turnaround_time;
+            done += t;
+            done_base += t_base;
+            if(t > last) last = t;
+            if(t_base > last_base) last_base = t_base;
+        }
+        printf("\n\nAverage completion time: %.2f (baseline %.2f, %+.1f%%)", (double)done/n, (double)done_base/n,
+            done_base > 0 ? 100.0*(done - done_base)/done_base : 0.0);
+        printf("\nLast completion: " TIME_FMT " (baseline " TIME_FMT ", %+.1f%%)", last, last_base,
+            last_base > 0 ? 100.0*(last - last_base)/last_base : 0.0);
+    }
+    printf("\n----------------------------------------------------------------\n");
+}
+
+void destroyGanttCores(GANTT **gantt, int n_cores) {
+    // Frees the GANTT charts of every core and the array
+    if(!gantt) return;
+    for(int c = 0; c < n_cores; c++) destroyGantt(gantt[c]);
+    free(gantt);
+}
+
+GANTT* applySwitchCost(GANTT *ghead, PROCESS *process, int n, SWITCH_COST cost) {
+    /*
+        INTRODUCTION:
+            Charges context switch overhead to a GANTT chart produced by any scheduling algorithm.
+
+        INPUT PARAMETERS:
+            - ghead (GANTT*): pointer to GANTT chart head (not modified, may come from getGanttBuffered()).
+            - process (PROCESS*): process array the chart was built from.
+            - n (int): number of processes.
+            - cost (SWITCH_COST): fixed and cache warm-up cost of a switch (not negative).
+
+        OUTPUT PARAMETERS:
+            - Recomputes wait and turnaround times of the processes.
+
+        RETURN VALUES:
+            - (GANTT*): pointer to a new GANTT chart head with context switch entries (pid -2),
+              NULL if any error (negative cost, entry whose pid is not IDLE or a pid of process).
+              Both charts are freed separately.
+
+        APPROACH:
+            - Traverse the chart keeping the accumulated delay, building the new chart with ganttAlloc().
+            - A dispatch is an entry of a process whose previous entry belongs to someone else.
+              Before every dispatch insert a switch entry of fixed + warm-up time, where warm-up
+              depends on how long the process has been away from the CPU, and add it to the delay.
+            - Shift process entries by the delay, IDLE entries absorb the delay (and vanish if they
+              are absorbed completely) since the CPU was waiting for an arrival there.
+            - The order of execution chosen by the algorithm is kept as it is.
+            - Finish time of the last entry of a process gives its new turnaround and wait time.
+    */
+
+    if(!ghead || !process || n < 1) {
+        printf("\nCannot read GANTT chart!\n");
+        return NULL;
+    }
+    if(cost.fixed < 0 || cost.warmup < 0) {
+        printf("\nInvalid context switch cost!\n");
+        return NULL;
+    }
+
+    int max_pid = 0;
+    for(int i = 0; i < n; i++)
+        if(process[i].pid > max_pid) max_pid = process[i].pid;
+
+    for(GANTT *g = ghead; g; g = g->next) {
+        if(g->pid < -1 || g->pid > max_pid) {
+            printf("\nInvalid pid %d in GANTT chart!\n", g->pid);
+            return NULL;
+        }
+    }
+
+    SCHED_TIME *last_run = (SCHED_TIME *)malloc((max_pid+1)*sizeof(SCHED_TIME));      // finish time of last run of each pid
+    for(int i = 0; i <= max_pid; i++) last_run[i] = -1;
+
+    GANTT *nhead = NULL, *ncurr = NULL;
+    SCHED_TIME delay = 0;
+    int prev_pid = -1;
+
+    for(GANTT *gcurr = ghead; gcurr != NULL; gcurr = gcurr->next)
+    {
+        SCHED_TIME start = gcurr->start_time + delay, finish = gcurr->finish_time + delay;
+
+        if(gcurr->pid == -1) {                      // IDLE absorbs the delay
+            SCHED_TIME len = gcurr->finish_time - gcurr->start_time;
+            if(delay >= len) {
+                delay -= len;
+                continue;
+            }
+            finish = gcurr->finish_time;
+            delay = 0;
+        }
+        else if(gcurr->pid != prev_pid) {           // dispatch: charge the switch
+            SCHED_TIME penalty = cost.warmup;
+            SCHED_TIME away = (last_run[gcurr->pid] == -1) ? -1 : start - last_run[gcurr->pid];
+
+            if(away >= 0 && cost.cold_after > 0 && away < cost.cold_after)
+                penalty = (SCHED_TIME)((long long)cost.warmup * away / cost.cold_after);
+
+            SCHED_TIME overhead = cost.fixed + penalty;
+            if(overhead > 0) {
+                GANTT *gnew = ganttAlloc();
+                gnew->pid = -2;                     // -2 for context switch
+                gnew->start_time = start;
+                gnew->finish_time = start + overhead;
+                gnew->next = NULL;
+                if(!nhead) nhead = ncurr = gnew;
+                else {
+                    ncurr->next = gnew;
+                    ncurr = gnew;
+                }
+                delay += overhead;
+                start += overhead;
+                finish += overhead;
+            }
+        }
+
+        GANTT *gnew = ganttAlloc();
+        gnew->pid = gcurr->pid;
+        gnew->start_time = start;
+        gnew->finish_time = finish;
+        gnew->next = NULL;
+        if(!nhead) nhead = ncurr = gnew;
+        else {
+            ncurr->next = gnew;
+            ncurr = gnew;
+        }
+
+        if(gcurr->pid >= 0) last_run[gcurr->pid] = finish;
+        prev_pid = gcurr->pid;
+    }
+
+    for(int i = 0; i < n; i++) {
+        if(process[i].pid < 0 || last_run[process[i].pid] == -1) continue;
+        process[i].turnaround_time = last_run[process[i].pid] - process[i].arrive_time;
+        process[i].wait_time = process[i].turnaround_time - process[i].initial_burst;
+    }
+
+    free(last_run);
+    return nhead;
+}
+
+void displaySwitchStats(GANTT *ghead) {
+    /*
+        INTRODUCTION:
+            Displays how much CPU time is spent on context switches.
+
+        INPUT PARAMETERS:
+            - ghead (GANTT*): pointer to GANTT chart head.
+
+        OUTPUT PARAMETERS:
+            - Prints switch count, overhead time and CPU percentages to console.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Traverse linked list and add up switch, IDLE and process entries.
+            - Percentages are relative to the total length of the chart.
+    */
+
+    if(!ghead) {
+        printf("\nCannot read GANTT chart!\n");
+        return;
+    }
+
+    long long busy = 0, idle = 0, overhead = 0;
+    int switches = 0;
+    SCHED_TIME start = ghead->start_time, finish = ghead->finish_time;
+
+    for(GANTT *gcurr = ghead; gcurr != NULL; gcurr = gcurr->next) {
+        SCHED_TIME len = gcurr->finish_time - gcurr->start_time;
+        if(gcurr->pid == -1) idle += len;
+        else if(gcurr->pid == -2) {
+            overhead += len;
+            switches++;
+        }
+        else busy += len;
+        finish = gcurr->finish_time;
+    }
+
+    double total = (finish - start > 0) ? (double)(finish - start) : 1.0;
+    printf("\n\nContext switches:-");
+    printf("\nSwitches: %d", switches);
+    printf("\nSwitch overhead: %lld", overhead);
+    printf("\nUseful CPU: %.2f%%", 100.0*busy/total);
+    printf("\nWasted CPU (switching): %.2f%%", 100.0*overhead/total);
+    printf("\nIdle CPU: %.2f%%", 100.0*idle/total);
+    printf("\n----------------------------------------------------------------\n");
+}
+
+int getEnergyModelFile(char *fileName, ENERGY_MODEL *model) {
+    /*
+        INTRODUCTION:
+            Reads the power model of the CPU from a file.
+
+        INPUT PARAMETERS:
+            - fileName (char*): path to file.
+            - model (ENERGY_MODEL*): model to fill.
+
+        OUTPUT PARAMETERS:
+            - Allocates model->state and fills the model.
+
+        RETURN VALUES:
+            - (int): number of performance states, -1 if any error.
+
+        APPROACH:
+            - Open file.
+            - Read the number of states, the IDLE power and the length of a time unit in seconds.
+            - Read speed and power of every state, speed must be positive and power not negative.
+            - Close file.
+    */
+
+    model->state = NULL;
+    model->n_states = 0;
+
+    FILE *fptr = fopen(fileName, "r");
+    if(!fptr) {
+        printf("\nFailed to open the file!\n");
+        return -1;
+    }
+
+    int n = 0;
+    double idle = -1, seconds = -1;
+    if(fscanf(fptr, "%d %lf %lf", &n, &idle, &seconds) != 3 || n < 1 || idle < 0 || seconds <= 0) {
+        printf("\nInvalid number of states/IDLE power/time unit!\n");
+        fclose(fptr);
+        return -1;
+    }
+
+    P_STATE *state = (P_STATE *)malloc(n*sizeof(P_STATE));
+    for(int k = 0; k < n; ++k) {
+        if(fscanf(fptr, "%lf %lf", &state[k].speed, &state[k].power) != 2 ||
+           state[k].speed <= 0 || state[k].power < 0) {
+            printf("\nInvalid value for speed/power at state %d!\n", k);
+            fclose(fptr);
+            free(state);
+            return -1;
+        }
+    }
+    fclose(fptr);
+
+    model->state = state;
+    model->n_states = n;
+    model->idle_power = idle;
+    model->seconds = seconds;
+    return n;
+}
+
+int getEnergy(GANTT *ghead, PROCESS *process, int n, ENERGY_MODEL *model, DVFS_POLICY policy, ENERGY_REPORT *report) {
+    /*
+        INTRODUCTION:
+            Computes the energy a schedule uses when the CPU changes performance state under a DVFS policy.
+
+        INPUT PARAMETERS:
+            - ghead (GANTT*): GANTT chart from any getGantt* (times at speed 1).
+            - process (PROCESS*): processes of the chart (arrival times, pid).
+            - n (int): number of processes.
+            - model (ENERGY_MODEL*): power model.
+            - policy (DVFS_POLICY): DVFS_RACE_TO_IDLE or DVFS_SLOW_AND_STEADY.
+            - report (ENERGY_REPORT*): report to fill.
+
+        OUTPUT PARAMETERS:
+            - Fills the report.
+
+        RETURN VALUES:
+            - (int): 0 if successful, -1 if any error.
+
+        APPROACH:
+            - Split the chart in busy periods (entries between two IDLE entries). The work of a period
+              (its length at speed 1) runs in one state:
+                - race to idle: the fastest state, then IDLE for the rest of the period;
+                - slow and steady: the slowest state that still finishes the work before the next
+                  busy period starts (the last period has no slack), the fastest one if none does.
+            - Every entry starts at its time in the chart or when the previous entry finishes,
+              whichever is later, so no process starts before it did at speed 1 (or before it arrives).
+            - Busy energy is the power of the state times the time spent running. IDLE energy covers
+              the rest of the time up to the later of both makespans, so both policies are charged
+              over the same interval.
+            - Turnaround time is the end of the last entry of a process minus its arrival time.
+              Processes without an entry in the chart are left out of the average.
+    */
+
+    if(!ghead || !process || n < 1 || !model || model->n_states < 1 || !report) {
+        printf("\nCannot compute energy!\n");
+        return -1;
+    }
+    if(policy < 0 || policy >= DVFS_COUNT) {
+        printf("\nInvalid DVFS policy!\n");
+        return -1;
+    }
+
+    int fastest = 0;
+    for(int k = 1; k < model->n_states; k++)
+        if(model->state[k].speed > model->state[fastest].speed) fastest = k;
+
+    int max_pid = 0;
+    for(int i = 0; i < n; i++)
+        if(process[i].pid > max_pid) max_pid = process[i].pid;
+    double *finish = (double *)malloc((max_pid+1)*sizeof(double));
+    for(int p = 0; p <= max_pid; p++) finish[p] = -1;   // -1 = no entry in the chart
+
+    double t = 0, busy_time = 0, busy_joules = 0;
+    SCHED_TIME chart_end = ghead->start_time;
+    GANTT *g = ghead;
+
+    while(g) {
+        if(g->pid == -1) {                          // IDLE: nothing to run
+            chart_end = g->finish_time;
+            g = g->next;
+            continue;
+        }
+
+        GANTT *first = g, *last = g;                // one busy period
+        while(last->next && last->next->pid != -1) last = last->next;
+        SCHED_TIME work = last->finish_time - first->start_time;
+        SCHED_TIME deadline = last->finish_time;    // start of the next busy period
+        if(last->next) {
+            GANTT *idle = last->next;
+            while(idle && idle->pid == -1) {
+                deadline = idle->finish_time;
+                idle = idle->next;
+            }
+            if(!idle) deadline = last->finish_time;  // trailing IDLE is not slack
+        }
+
+        P_STATE *ps = &model->state[fastest];
+        if(policy == DVFS_SLOW_AND_STEADY) {
+            double start = (t > first->start_time) ? t : (double)first->start_time;
+            double needed = (deadline > start) ? work / (deadline - start) : model->state[fastest].speed;
+            for(int k = 0; k < model->n_states; k++)
+                if(model->state[k].speed >= needed - 1e-12 && model->state[k].speed < ps->speed) ps = &model->state[k];
+        }
+
+        for(GANTT *e = first; ; e = e->next) {
+            double run = (e->finish_time - e->start_time) / ps->speed;
+            if(t < e->start_time) t = e->start_time;
+            t += run;
+            busy_time += run;
+            busy_joules += ps->power * run * model->seconds;
+            if(e->pid >= 0 && e->pid <= max_pid) finish[e->pid] = t;
+            if(e == last) break;
+        }
+        chart_end = last->finish_time;
+        g = last->next;
+    }
+
+    double horizon = (t > chart_end) ? t : (double)chart_end;
+    double tat = 0;
+    int finished = 0;
+    for(int i = 0; i < n; i++)
+        if(process[i].pid >= 0 && finish[process[i].pid] >= 0) {
+            tat += finish[process[i].pid] - process[i].arrive_time;
+            finished++;
+        }
+    free(finish);
+
+    report->busy_joules = busy_joules;
+    report->idle_joules = model->idle_power * (horizon - ghead->start_time - busy_time) * model->seconds;
+    report->joules = report->busy_joules + report->idle_joules;
+    report->busy_time = busy_time;
+    report->makespan = t;
+    report->avg_turnaround = finished ? tat / finished : 0;
+    report->edp = report->joules * t * model->seconds;
+    return 0;
+}
+
+void displayEnergy(ENERGY_REPORT *report, int count) {
+    /*
+        INTRODUCTION:
+            Displays energy reports, one row per DVFS policy.
+
+        INPUT PARAMETERS:
+            - report (ENERGY_REPORT*): report[k] was computed with DVFS policy k.
+            - count (int): number of reports.
+
+        OUTPUT PARAMETERS:
+            - Prints the table to console.
+
+        RETURN VALUES:
+            - None.
+    */
+
+    if(!report) {
+        printf("\nCannot display energy!\n");
+        return;
+    }
+
+    printf("\n\nEnergy:-");
+    printf("\nPolicy\t\tBusy J\t\tIdle J\t\tTotal J\t\tMakespan\tAvg TAT\t\tEDP (J*s)");
+    printf("\n----------------------------------------------------------------------------------------------------------");
+    for(int k = 0; k < count; k++)
+        printf("\n%-16s%-16.3f%-16.3f%-16.3f%-16.2f%-16.2f%.4f", dvfsNames[k], report[k].busy_joules,
+            report[k].idle_joules, report[k].joules, report[k].makespan, report[k].avg_turnaround, report[k].edp);
+    printf("\n----------------------------------------------------------------------------------------------------------\n");
+}
+
+void displayGantt(GANTT *ghead) {
+    /*
+        INTRODUCTION:
+            Displays GANTT chart scheduling output.
+
+        INPUT PARAMETERS:
+            - ghead (GANTT*): pointer to GANTT chart head.
+
+        OUTPUT PARAMETERS:
+            - Prints GANTT chart to console.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Traverse linked list and print PID, start and finish times.
+    */
+
+    if(!ghead) {
+        printf("\nCannot read GANTT chart!\n");
+        return;
+    }
+
+    printf("\nGant Chart:-");
+    printf("\nStart\tPID\tFinish\n------------------------");
+    GANTT *gnew = ghead;
+    while(gnew != NULL)
+    {
+        if(gnew->pid == -1)
+            printf("\n" TIME_FMT "\tIDLE\t" TIME_FMT "\t", gnew->start_time, gnew->finish_time);
+        else if(gnew->pid == -2)
+            printf("\n" TIME_FMT "\tCS\t" TIME_FMT "\t", gnew->start_time, gnew->finish_time);
+        else
+            printf("\n" TIME_FMT "\tP%d\t" TIME_FMT, gnew->start_time, gnew->pid, gnew->finish_time);
+
+        gnew = gnew->next;
+    }
+    printf("\n----------------------------------------------------------------\n");
+}
+
+void destroyGantt(GANTT *ghead) {
+    /*
+        INTRODUCTION:
+            Frees allocated memory for GANTT chart.
+
+        INPUT PARAMETERS:
+            - ghead (GANTT*): pointer to GANTT chart head.
+
+        OUTPUT PARAMETERS:
+            - Frees dynamically allocated memory.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Traverse linked list and free each node using schedFree() (nothing to do if an arena is bound).
+    */
+
+    GANTT *gcurr = ghead;
+    while(ghead) {
+        gcurr = ghead;
+        ghead = ghead->next;
+        schedFree(gcurr);
+    }
+}
+
+int exportChromeTrace(char *fileName, GANTT *ghead, PROCESS *process, int n) {
+    /*
+        INTRODUCTION:
+            Exports a GANTT chart and process events in Chrome Trace Event (JSON) format,
+            viewable in chrome://tracing or ui.perfetto.dev.
+
+        INPUT PARAMETERS:
+            - fileName (char*): path of the trace file to write.
+            - ghead (GANTT*): pointer to GANTT chart head.
+            - process (PROCESS*): process array (after scheduling), may be NULL.
+            - n (int): number of processes.
+
+        OUTPUT PARAMETERS:
+            - Writes the trace file.
+
+        RETURN VALUES:
+            - (int): number of GANTT entries written, -1 if any error.
+
+        APPROACH:
+            - Trace pid 0 is the CPU (one track per CPU), trace pid 1 holds one track per process.
+            - Print track names, then the arrival and completion instants of every process.
+            - Traverse the linked list once and print every entry as a complete ("X") event
+              on the CPU track and on the process track, without building it in memory first.
+            - One unit of scheduling time is one microsecond in the trace.
+    */
+
+    if(!ghead) {
+        printf("\nCannot read GANTT chart!\n");
+        return -1;
+    }
+
+    FILE *fptr = fopen(fileName, "w");
+    if(!fptr) {
+        printf("\nFailed to open the file!\n");
+        return -1;
+    }
+
+    fprintf(fptr, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(fptr, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"CPU\"}},\n");
+    fprintf(fptr, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"CPU 0\"}},\n");
+    fprintf(fptr, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Processes\"}}");
+
+    for(int i = 0; process && i < n; i++) {
+        fprintf(fptr, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"P%d\"}}",
+                process[i].pid, process[i].pid);
+        fprintf(fptr, ",\n{\"name\":\"arrive\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":" TIME_FMT "}",
+                process[i].pid, process[i].arrive_time);
+        fprintf(fptr, ",\n{\"name\":\"complete\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":" TIME_FMT "}",
+                process[i].pid, process[i].arrive_time + process[i].turnaround_time);
+    }
+
+    int count = 0;
+    GANTT *gcurr = ghead;
+    while(gcurr != NULL)
+    {
+        SCHED_TIME dur = gcurr->finish_time - gcurr->start_time;
+        if(gcurr->pid == -1) {
+            fprintf(fptr, ",\n{\"name\":\"IDLE\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":" TIME_FMT ",\"dur\":" TIME_FMT "}",
+                    gcurr->start_time, dur);
+        }
+        else if(gcurr->pid == -2) {
+            fprintf(fptr, ",\n{\"name\":\"SWITCH\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":" TIME_FMT ",\"dur\":" TIME_FMT "}",
+                    gcurr->start_time, dur);
+        }
+        else {
+            fprintf(fptr, ",\n{\"name\":\"P%d\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":" TIME_FMT ",\"dur\":" TIME_FMT "}",
+                    gcurr->pid, gcurr->start_time, dur);
+            fprintf(fptr, ",\n{\"name\":\"run\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":" TIME_FMT ",\"dur\":" TIME_FMT "}",
+                    gcurr->pid, gcurr->start_time, dur);
+        }
+        count++;
+        gcurr = gcurr->next;
+    }
+
+    fprintf(fptr, "\n]}\n");
+    fclose(fptr);
+    return count;
+}
+
+GANTT_RLE* createGanttRLE() {
+    /*
+        INTRODUCTION:
+            Creates an empty compressed GANTT chart.
+
+        RETURN VALUES:
+            - (GANTT_RLE*): the chart, free it with destroyGanttRLE().
+
+        APPROACH:
+            - Memory comes from malloc, not from the scratch arena, since the buffers grow with realloc
+              and usually outlive the simulation.
+    */
+
+    GANTT_RLE *rle = (GANTT_RLE *)calloc(1, sizeof(GANTT_RLE));
+    rle->capacity = 4096;
+    rle->data = (unsigned char *)malloc(rle->capacity);
+    rle->check_capacity = 16;
+    rle->check = (RLE_CHECKPOINT *)malloc(rle->check_capacity*sizeof(RLE_CHECKPOINT));
+    return rle;
+}
+
+void rlePutVarint(GANTT_RLE *rle, unsigned long long value) {
+    // Appends value with 7 bits per byte, the high bit is set on every byte but the last one
+    while(value >= 0x80) {
+        rle->data[rle->size++] = (unsigned char)(value | 0x80);
+        value >>= 7;
     }
+    rle->data[rle->size++] = (unsigned char)value;
+}
 
-    GANTT *ghead = NULL, *gnew = NULL, *gcurr = NULL;
-    int completed = 0, curr_time = 0;
+unsigned long long rleGetVarint(const unsigned char *data, size_t *offset) {
+    // Reads the varint at *offset and moves *offset past it
+    unsigned long long value = 0;
+    int shift = 0;
+    while(data[*offset] & 0x80) {
+        value |= (unsigned long long)(data[(*offset)++] & 0x7f) << shift;
+        shift += 7;
+    }
+    value |= (unsigned long long)data[(*offset)++] << shift;
+    return value;
+}
 
-    while (completed < n) {
-        int min_idx = -1;
-        int min_burst = INT_MAX;
+int rleAppend(GANTT_RLE *rle, int pid, SCHED_TIME start_time, SCHED_TIME finish_time) {
+    /*
+        INTRODUCTION:
+            Appends a segment to a compressed GANTT chart.
 
-        for (int i = 0; i < n; i++) {
-            if (process[i].arrive_time <= curr_time && process[i].burst_time > 0) {
-                if (process[i].burst_time < min_burst) {
-                    min_burst = process[i].burst_time;
-                    min_idx = i;
-                }
-            }
-        }
+        INPUT PARAMETERS:
+            - rle (GANTT_RLE*): chart.
+            - pid (int): process ID (-1 for IDLE, -2 for context switch).
+            - start_time, finish_time (SCHED_TIME): time slot of the segment.
 
-        GANTT *gnew = (GANTT*)malloc(sizeof(GANTT));
+        OUTPUT PARAMETERS:
+            - Encodes the segment at the end of rle->data, adds a checkpoint every RLE_CHECKPOINT_EVERY segments.
 
-        if(min_idx == -1) {            // system is IDLE
-            gnew->pid = -1;
-            gnew->start_time = curr_time;
-            gnew->finish_time = curr_time + 1;
-            gnew->next = NULL;
-        }
-        else {
-            gnew->pid = process[min_idx].pid;
-            gnew->start_time = curr_time;
-            gnew->finish_time = curr_time + 1;
-            gnew->next = NULL;
+        RETURN VALUES:
+            - (int): 0 on success, -1 if any error.
 
-            process[min_idx].burst_time--;
+        APPROACH:
+            - The start time is stored relative to the previous finish time, zigzag encoded so a gap
+              or an overlap both stay small (it is 0 for the output of the schedulers).
+            - A segment of a chart with small process IDs and slices takes three bytes.
+    */
 
-            if (process[min_idx].burst_time == 0) {
-                completed++;
-                process[min_idx].turnaround_time = gnew->finish_time - process[min_idx].arrive_time;
-                process[min_idx].wait_time = process[min_idx].turnaround_time - process[min_idx].initial_burst;
-            }
-        }
+    if(!rle || pid < -2 || finish_time < start_time) {
+        printf("\nInvalid GANTT chart entry!\n");
+        return -1;
+    }
 
-        if(gcurr) {
-            if(min_idx == -1 && gcurr->pid == -1) {
-                gcurr->finish_time = gnew->finish_time;
-                free(gnew);
-                gnew = NULL;
-            }
-            if(min_idx != -1 && (gcurr->pid == process[min_idx].pid)) {
-                gcurr->finish_time = gnew->finish_time;
-                free(gnew);
-                gnew = NULL;
-            }
+    if(rle->count % RLE_CHECKPOINT_EVERY == 0) {
+        if(rle->n_check == rle->check_capacity) {
+            rle->check_capacity *= 2;
+            rle->check = (RLE_CHECKPOINT *)realloc(rle->check, rle->check_capacity*sizeof(RLE_CHECKPOINT));
         }
+        rle->check[rle->n_check].offset = rle->size;
+        rle->check[rle->n_check].index = rle->count;
+        rle->check[rle->n_check].last = rle->last;
+        rle->n_check++;
+    }
 
-        if(!ghead) {
-            ghead = gcurr = gnew;
-        }
-        else {
-            if(gnew) {
-                gcurr->next = gnew;
-                gcurr = gnew;
-            }
-        }
-        curr_time++;
+    if(rle->size + 30 > rle->capacity) {        // three varints of at most 10 bytes
+        rle->capacity *= 2;
+        rle->data = (unsigned char *)realloc(rle->data, rle->capacity);
     }
 
-    return ghead;
+    long long gap = (long long)start_time - (long long)rle->last;
+    rlePutVarint(rle, (unsigned long long)(pid + 2));
+    rlePutVarint(rle, ((unsigned long long)gap << 1) ^ (unsigned long long)(gap >> 63));
+    rlePutVarint(rle, (unsigned long long)(finish_time - start_time));
+    rle->count++;
+    rle->last = finish_time;
+    return 0;
 }
 
-GANTT* getGanttPriorityPreemptive(PROCESS *process, int n) {
+void rleBegin(GANTT_RLE *rle, GANTT_CURSOR *cursor) {
+    // Positions cursor before the first segment
+    cursor->rle = rle;
+    cursor->offset = 0;
+    cursor->index = 0;
+    cursor->last = 0;
+}
+
+int rleNext(GANTT_CURSOR *cursor, GANTT *seg) {
     /*
         INTRODUCTION:
-            Simulates Priority Preemptive scheduling.
+            Decodes the segment at the cursor and moves the cursor past it.
 
         INPUT PARAMETERS:
-            - process (PROCESS*): process array.
-            - n (int): number of processes.
+            - cursor (GANTT_CURSOR*): position from rleBegin() or rleSeek().
 
         OUTPUT PARAMETERS:
-            - Constructs GANTT chart linked list.
+            - seg (GANTT*): the segment (seg->next is set to NULL).
 
         RETURN VALUES:
-            - (GANTT*): pointer to GANTT chart head.
-
-        APPROACH:
-            - Sort processes on arrival times, or on priority if arrival times are same.
-            - At each time unit, pick highest-priority (lowest value) process.
-            - Preempt if a higher-priority process arrives.
-            - Update GANTT chart and process stats.
+            - (int): 1 if a segment was decoded, 0 at the end of the chart.
     */
 
-    if(n < 1 || !process) {
-        printf("\nInvalid number of Processes!\n");
-        return NULL;
-    }
+    GANTT_RLE *rle = cursor->rle;
+    if(cursor->index >= rle->count) return 0;
+
+    int pid = (int)rleGetVarint(rle->data, &cursor->offset) - 2;
+    unsigned long long zigzag = rleGetVarint(rle->data, &cursor->offset);
+    long long gap = (long long)(zigzag >> 1) ^ -(long long)(zigzag & 1);
+    SCHED_TIME dur = (SCHED_TIME)rleGetVarint(rle->data, &cursor->offset);
+
+    seg->pid = pid;
+    seg->start_time = cursor->last + (SCHED_TIME)gap;
+    seg->finish_time = seg->start_time + dur;
+    seg->next = NULL;
+    cursor->last = seg->finish_time;
+    cursor->index++;
+    return 1;
+}
 
-    if(process) {
-        for(int i = 0; i < n-1; i++)                // sort according to arrival time
-        {
-            for(int j = i+1; j < n; j++)
-            {
-                if(process[i].arrive_time > process[j].arrive_time)
-                {
-                    PROCESS t = process[i];
-                    process[i] = process[j];
-                    process[j] = t;
-                    continue;
-                }
+long long rleSeek(GANTT_RLE *rle, SCHED_TIME time, GANTT_CURSOR *cursor) {
+    /*
+        INTRODUCTION:
+            Positions a cursor at the segment running at a given time.
 
-                if(process[i].arrive_time == process[j].arrive_time) {          // if same arrival time, sort on priority
-                    if(process[i].priority > process[j].priority) {
-                        PROCESS t = process[i];
-                        process[i] = process[j];
-                        process[j] = t;
-                    }
-                }
-            }
-        }
-    }
-    else {
-        printf("\nFailed to read the processes!\n");
-        return NULL;
-    }
+        INPUT PARAMETERS:
+            - rle (GANTT_RLE*): chart, its segments in time order.
+            - time (SCHED_TIME): time to look up.
 
-    GANTT *ghead = NULL, *gnew = NULL, *gcurr = NULL;
-    int completed = 0, curr_time = 0;
+        OUTPUT PARAMETERS:
+            - cursor (GANTT_CURSOR*): positioned so rleNext() returns the first segment finishing after time.
 
-    while (completed < n) {
-        int min_idx = -1;
-        int min_priority = INT_MAX;
+        RETURN VALUES:
+            - (long long): index of that segment, -1 if every segment finishes at or before time.
 
-        for (int i = 0; i < n; i++) {
-            if (process[i].arrive_time <= curr_time && process[i].burst_time > 0) {
-                if (process[i].priority < min_priority) {
-                    min_priority = process[i].priority;
-                    min_idx = i;
-                }
-            }
-        }
+        APPROACH:
+            - Binary search for the last checkpoint whose previous segment finished at or before time,
+              then decode at most RLE_CHECKPOINT_EVERY segments from there.
+    */
 
-        GANTT *gnew = (GANTT*)malloc(sizeof(GANTT));
+    rleBegin(rle, cursor);
+    if(rle->n_check == 0) return -1;
 
-        if(min_idx == -1) {            // system is IDLE
-            gnew->pid = -1;
-            gnew->start_time = curr_time;
-            gnew->finish_time = curr_time + 1;
-            gnew->next = NULL;
+    long long lo = 0, hi = rle->n_check - 1;
+    while(lo < hi) {
+        long long mid = (lo + hi + 1) / 2;
+        if(rle->check[mid].last <= time) lo = mid;
+        else hi = mid - 1;
+    }
+    cursor->offset = rle->check[lo].offset;
+    cursor->index = rle->check[lo].index;
+    cursor->last = rle->check[lo].last;
+
+    GANTT seg;
+    GANTT_CURSOR prev = *cursor;
+    while(rleNext(cursor, &seg)) {
+        if(seg.finish_time > time) {
+            *cursor = prev;
+            return cursor->index;
         }
-        else {
-            gnew->pid = process[min_idx].pid;
-            gnew->start_time = curr_time;
-            gnew->finish_time = curr_time + 1;
-            gnew->next = NULL;
+        prev = *cursor;
+    }
+    return -1;
+}
 
-            process[min_idx].burst_time--;
+GANTT_RLE* ganttCompress(GANTT *ghead) {
+    // Encodes a GANTT linked list, the list is left unchanged
+    if(!ghead) {
+        printf("\nCannot read GANTT chart!\n");
+        return NULL;
+    }
 
-            if (process[min_idx].burst_time == 0) {
-                completed++;
-                process[min_idx].turnaround_time = gnew->finish_time - process[min_idx].arrive_time;
-                process[min_idx].wait_time = process[min_idx].turnaround_time - process[min_idx].initial_burst;
-            }
-        }
+    GANTT_RLE *rle = createGanttRLE();
+    for(GANTT *gcurr = ghead; gcurr; gcurr = gcurr->next)
+        rleAppend(rle, gcurr->pid, gcurr->start_time, gcurr->finish_time);
+    return rle;
+}
 
-        if(gcurr) {
-            if(min_idx == -1 && gcurr->pid == -1) {
-                gcurr->finish_time = gnew->finish_time;
-                free(gnew);
-                gnew = NULL;
-            }
-            if(min_idx != -1 && (gcurr->pid == process[min_idx].pid)) {
-                gcurr->finish_time = gnew->finish_time;
-                free(gnew);
-                gnew = NULL;
-            }
-        }
+GANTT* ganttDecompress(GANTT_RLE *rle) {
+    // Decodes a compressed GANTT chart into a linked list, entry for entry
+    if(!rle || rle->count == 0) {
+        printf("\nCannot read GANTT chart!\n");
+        return NULL;
+    }
 
-        if(!ghead) {
-            ghead = gcurr = gnew;
-        }
+    GANTT *ghead = NULL, *gcurr = NULL, seg;
+    GANTT_CURSOR cursor;
+    rleBegin(rle, &cursor);
+    while(rleNext(&cursor, &seg)) {
+        GANTT *gnew = ganttAlloc();
+        *gnew = seg;
+        if(!ghead) ghead = gcurr = gnew;
         else {
-            if(gnew) {
-                gcurr->next = gnew;
-                gcurr = gnew;
-            }
+            gcurr->next = gnew;
+            gcurr = gnew;
         }
-        curr_time++;
     }
-
     return ghead;
 }
 
-GANTT* getGanttLRTF(PROCESS *process, int n) {
+GANTT_RLE* getGanttCompressed(SCHED_POLICY policy, PROCESS *process, int n, SCHED_TIME time_slice) {
     /*
         INTRODUCTION:
-            Simulates Longest Remaining Time First (LRTF) preemptive scheduling.
+            Runs the scheduling algorithm selected by policy and returns a compressed GANTT chart.
 
         INPUT PARAMETERS:
+            - policy (SCHED_POLICY): algorithm to run.
             - process (PROCESS*): process array.
             - n (int): number of processes.
+            - time_slice (SCHED_TIME): time quantum, only used by Round Robin.
 
         OUTPUT PARAMETERS:
-            - Constructs GANTT chart linked list.
+            - Fills the wait and turnaround times of process like the getGantt* functions.
 
         RETURN VALUES:
-            - (GANTT*): pointer to GANTT chart head.
+            - (GANTT_RLE*): the chart, NULL if any error.
 
         APPROACH:
-            - Sort processes on arrival time, or on burst time in descending order if arrival times are same.
-            - At each time unit, run process with longest remaining time.
-            - Preempt if necessary.
-            - Update GANTT chart and process stats.
+            - Every entry is encoded as it is produced, no linked list is built.
     */
 
-    if(n < 1 || !process) {
-        printf("\nInvalid number of Processes!\n");
+    if(policy < 0 || policy >= POLICY_COUNT) {
+        printf("\nInvalid scheduling policy!\n");
         return NULL;
     }
 
-    if(process) {
-        for(int i = 0; i < n-1; i++)                // sort according to arrival time
-        {
-            for(int j = i+1; j < n; j++)
-            {
-                if(process[i].arrive_time > process[j].arrive_time)
-                {
-                    PROCESS t = process[i];
-                    process[i] = process[j];
-                    process[j] = t;
-                    continue;
-                }
-                if(process[i].arrive_time == process[j].arrive_time) {          // if same arrival time, sort on burst time in descending order
-                    if(process[i].burst_time < process[j].burst_time) {
-                        PROCESS t = process[i];
-                        process[i] = process[j];
-                        process[j] = t;
-                    }
-                }
-            }
-        }
-    }
-    else {
-        printf("\nFailed to read the processes!\n");
+    GANTT_RLE *rle = createGanttRLE();
+    GANTT_SINK sink;
+    sinkInit(&sink, rle, policyMerges[policy]);
+    policySimulators[policy](process, n, time_slice, &sink);
+
+    if(rle->count == 0) {                       // the algorithm rejected its input
+        destroyGanttRLE(rle);
         return NULL;
     }
+    return rle;
+}
 
-    GANTT *ghead = NULL, *gnew = NULL, *gcurr = NULL;
-    int completed = 0, curr_time = 0;
-
-    while (completed < n) {
-        int max_idx = -1;
-        int max_burst = INT_MIN;
-
-        for (int i = 0; i < n; i++) {
-            if (process[i].arrive_time <= curr_time && process[i].burst_time > 0) {
-                if (process[i].burst_time > max_burst) {
-                    max_burst = process[i].burst_time;
-                    max_idx = i;
-                }
-            }
-        }
-
-        GANTT *gnew = (GANTT*)malloc(sizeof(GANTT));
-
-        if(max_idx == -1) {            // system is IDLE
-            gnew->pid = -1;
-            gnew->start_time = curr_time;
-            gnew->finish_time = curr_time + 1;
-            gnew->next = NULL;
-        }
-        else {
-            gnew->pid = process[max_idx].pid;
-            gnew->start_time = curr_time;
-            gnew->finish_time = curr_time + 1;
-            gnew->next = NULL;
-
-            process[max_idx].burst_time--;
+void displayGanttRLE(GANTT_RLE *rle) {
+    // Displays a compressed GANTT chart like displayGantt(), decoding one entry at a time
+    if(!rle || rle->count == 0) {
+        printf("\nCannot read GANTT chart!\n");
+        return;
+    }
 
-            if (process[max_idx].burst_time == 0) {
-                completed++;
-                process[max_idx].turnaround_time = gnew->finish_time - process[max_idx].arrive_time;
-                process[max_idx].wait_time = process[max_idx].turnaround_time - process[max_idx].initial_burst;
-            }
-        }
+    GANTT seg;
+    GANTT_CURSOR cursor;
+    rleBegin(rle, &cursor);
+    printf("\nGant Chart:-");
+    printf("\nStart\tPID\tFinish\n------------------------");
+    while(rleNext(&cursor, &seg))
+    {
+        if(seg.pid == -1)
+            printf("\n" TIME_FMT "\tIDLE\t" TIME_FMT "\t", seg.start_time, seg.finish_time);
+        else if(seg.pid == -2)
+            printf("\n" TIME_FMT "\tCS\t" TIME_FMT "\t", seg.start_time, seg.finish_time);
+        else
+            printf("\n" TIME_FMT "\tP%d\t" TIME_FMT, seg.start_time, seg.pid, seg.finish_time);
+    }
+    printf("\n----------------------------------------------------------------\n");
+}
 
-        if(gcurr) {
-            if(max_idx == -1 && gcurr->pid == -1) {
-                gcurr->finish_time = gnew->finish_time;
-                free(gnew);
-                gnew = NULL;
-            }
-            if(max_idx != -1 && (gcurr->pid == process[max_idx].pid)) {
-                gcurr->finish_time = gnew->finish_time;
-                free(gnew);
-                gnew = NULL;
-            }
-        }
+void destroyGanttRLE(GANTT_RLE *rle) {
+    // Frees a compressed GANTT chart
+    if(!rle) return;
+    free(rle->data);
+    free(rle->check);
+    free(rle);
+}
 
-        if(!ghead) {
-            ghead = gcurr = gnew;
-        }
-        else {
-            if(gnew) {
-                gcurr->next = gnew;
-                gcurr = gnew;
-            }
-        }
-        curr_time++;
-    }
+GANTT_INDEX* allocGanttIndex(long long count) {
+    // Allocates an index of count entries
+    GANTT_INDEX *index = (GANTT_INDEX *)malloc(sizeof(GANTT_INDEX));
+    index->count = count;
+    index->start = (SCHED_TIME *)malloc(count*sizeof(SCHED_TIME));
+    index->finish = (SCHED_TIME *)malloc(count*sizeof(SCHED_TIME));
+    index->pid = (int *)malloc(count*sizeof(int));
+    index->busy = (SCHED_TIME *)malloc((count+1)*sizeof(SCHED_TIME));
+    return index;
+}
 
-    return ghead;
+void indexBusySums(GANTT_INDEX *index) {
+    // Fills the running sum of process time
+    index->busy[0] = 0;
+    for(long long i = 0; i < index->count; i++)
+        index->busy[i+1] = index->busy[i] + (index->pid[i] >= 0 ? index->finish[i] - index->start[i] : 0);
 }
 
-GANTT* getGanttRoundRobin(PROCESS *process, int n, int time_slice) {
+GANTT_INDEX* createGanttIndex(GANTT *ghead) {
     /*
         INTRODUCTION:
-            Implements the Round Robin CPU scheduling algorithm.
+            Builds the time-window index of a GANTT chart.
 
         INPUT PARAMETERS:
-            - process (PROCESS*): Array of process structure
-            - n (int): Number of processes.
-            - time_slice (int): The time quantum for the Round Robin scheduling.
-
-        OUTPUT PARAMETERS:
-            - Constructs Gantt chart linked list
+            - ghead (GANTT*): pointer to GANTT chart head, entries in time order and not overlapping
+              (every chart of this library).
 
         RETURN VALUES:
-            - ghead (GANTT*): Pointer to the head of the GANTT linked list representing the scheduling timeline.
+            - (GANTT_INDEX*): the index, free it with destroyGanttIndex(); NULL if any error.
 
         APPROACH:
-            - Validate number of processes and time_slice.
-            - Sort processes based on their arrival time.
-            - Initialize a circular queue to manage the scheduling order.
-            - Run a loop until all processes are completed:
-            - Update GANTT chart and process stats.
+            - Copy the entries into arrays (one pass to count, one to copy) and sum the process time,
+              the chart itself is not needed afterwards.
     */
 
-    if(n < 1 || !process) {
-        printf("\nInvalid number of Processes!\n");
+    if(!ghead) {
+        printf("\nCannot read GANTT chart!\n");
         return NULL;
     }
 
-    if(time_slice <= 0) {
-        printf("\nInvalid value of Time Slice!\n");
-        return NULL;
-    }
+    long long count = 0;
+    for(GANTT *gcurr = ghead; gcurr; gcurr = gcurr->next) count++;
 
-    if(process) {
-        for(int i = 0; i < n-1; i++)                // sort according to arrival time
-        {
-            for(int j = i+1; j < n; j++)
-            {
-                if(process[i].arrive_time > process[j].arrive_time)
-                {
-                    PROCESS t = process[i];
-                    process[i] = process[j];
-                    process[j] = t;
-                    continue;
-                }
-            }
-        }
+    GANTT_INDEX *index = allocGanttIndex(count);
+    long long i = 0;
+    for(GANTT *gcurr = ghead; gcurr; gcurr = gcurr->next, i++) {
+        index->start[i] = gcurr->start_time;
+        index->finish[i] = gcurr->finish_time;
+        index->pid[i] = gcurr->pid;
     }
-    else {
-        printf("\nFailed to read the processes!\n");
+    indexBusySums(index);
+    return index;
+}
+
+GANTT_INDEX* createGanttIndexRLE(GANTT_RLE *rle) {
+    // Builds the time-window index of a compressed GANTT chart, like createGanttIndex()
+    if(!rle || rle->count == 0) {
+        printf("\nCannot read GANTT chart!\n");
         return NULL;
     }
 
-    GANTT *ghead = NULL, *gnew = NULL, *gcurr = NULL;
-    int completed = 0, curr_time = 0;
-    int queue[n], front = 0, rear = -1, q_size = 0;
-    int *in_queue = (int *)calloc(n, sizeof(int));
+    GANTT_INDEX *index = allocGanttIndex(rle->count);
+    GANTT seg;
+    GANTT_CURSOR cursor;
+    rleBegin(rle, &cursor);
+    for(long long i = 0; rleNext(&cursor, &seg); i++) {
+        index->start[i] = seg.start_time;
+        index->finish[i] = seg.finish_time;
+        index->pid[i] = seg.pid;
+    }
+    indexBusySums(index);
+    return index;
+}
 
-    while (completed < n) {
+long long indexFirstAfter(GANTT_INDEX *index, SCHED_TIME time) {
+    // Binary search for the first entry finishing after time (count if there is none)
+    long long lo = 0, hi = index->count;
+    while(lo < hi) {
+        long long mid = lo + (hi - lo) / 2;
+        if(index->finish[mid] > time) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo;
+}
 
-        for(int i = 0; i < n; i++) {
-            if(process[i].arrive_time <= curr_time && process[i].burst_time > 0 && !in_queue[i]) {
-                rear = (rear+1)%n;
-                queue[rear] = i;
-                in_queue[i] = 1;
-                q_size++;
-            }
-        }
+long long ganttIndexAt(GANTT_INDEX *index, SCHED_TIME time) {
+    /*
+        INTRODUCTION:
+            Finds the entry running at a point in time, in O(log n).
 
-        GANTT *gnew = (GANTT*)malloc(sizeof(GANTT));
+        INPUT PARAMETERS:
+            - index (GANTT_INDEX*): indexed chart.
+            - time (SCHED_TIME): point in time.
 
-        if(q_size == 0) {            // queue is empty and system is IDLE
-            gnew->pid = -1;
-            gnew->start_time = curr_time;
-            gnew->finish_time = curr_time + 1;
-            gnew->next = NULL;
-            curr_time++;
+        RETURN VALUES:
+            - (long long): index i of the entry with start[i] <= time < finish[i], -1 if there is none
+              (before the chart, after it, or in a gap of an arbitrary chart).
+    */
 
-            if (!ghead) ghead = gcurr = gnew;
-            else {
-                if(gcurr && gcurr->pid == -1) {
-                    gcurr->finish_time = gnew->finish_time;
-                    free(gnew);
-                    gnew = NULL;
-                }
-                else {
-                    gcurr->next = gnew;
-                    gcurr = gnew;
-                }
-            }
-            continue;
-        }
+    long long i = indexFirstAfter(index, time);
+    if(i == index->count || index->start[i] > time) return -1;
+    return i;
+}
 
-        int curr_idx = queue[front];
-        front = (front+1)%n;
-        q_size--;
+long long ganttIndexRange(GANTT_INDEX *index, SCHED_TIME t1, SCHED_TIME t2, long long *first) {
+    /*
+        INTRODUCTION:
+            Finds the entries that overlap a time window, in O(log n).
 
-        gnew->pid = process[curr_idx].pid;
-        gnew->start_time = curr_time;
-        int exec_time = (process[curr_idx].burst_time > time_slice) ? time_slice : process[curr_idx].burst_time;
-        gnew->finish_time = curr_time + exec_time;
-        gnew->next = NULL;
+        INPUT PARAMETERS:
+            - index (GANTT_INDEX*): indexed chart.
+            - t1, t2 (SCHED_TIME): window [t1, t2).
 
-        process[curr_idx].burst_time -= exec_time;
-        curr_time += exec_time;
+        OUTPUT PARAMETERS:
+            - first (long long*): index of the first overlapping entry, the others follow it.
 
-        if(!ghead) ghead = gcurr = gnew;
-        else {
-            gcurr->next = gnew;
-            gcurr = gnew;
-        }
+        RETURN VALUES:
+            - (long long): number of overlapping entries (0 if none or if t2 <= t1).
+    */
 
-        for (int i = 0; i < n; ++i) {
-            if (process[i].arrive_time <= curr_time && process[i].burst_time > 0 && !in_queue[i]) {
-                rear = (rear+1)%n;
-                queue[rear] = i;
-                in_queue[i] = 1;
-                q_size++;
-            }
-        }
+    *first = indexFirstAfter(index, t1);
+    if(t2 <= t1) return 0;
 
-        if(process[curr_idx].burst_time > 0) {
-            rear = (rear+1)%n;
-            queue[rear] = curr_idx;
-            q_size++;
-        }
-        else {
-            completed++;
-            process[curr_idx].turnaround_time = gnew->finish_time - process[curr_idx].arrive_time;
-            process[curr_idx].wait_time = process[curr_idx].turnaround_time - process[curr_idx].initial_burst;
-        }
+    long long lo = *first, hi = index->count;   // first entry starting at or after t2
+    while(lo < hi) {
+        long long mid = lo + (hi - lo) / 2;
+        if(index->start[mid] >= t2) hi = mid;
+        else lo = mid + 1;
     }
-    free(in_queue);
-    return ghead;
+    return lo - *first;
 }
 
-void displayGantt(GANTT *ghead) {
+SCHED_TIME indexBusyBefore(GANTT_INDEX *index, long long i, SCHED_TIME time) {
+    // Process time before time, given i = indexFirstAfter(index, time)
+    SCHED_TIME busy = index->busy[i];
+    if(i < index->count && index->pid[i] >= 0 && index->start[i] < time) busy += time - index->start[i];
+    return busy;
+}
+
+SCHED_TIME ganttIndexBusy(GANTT_INDEX *index, SCHED_TIME t1, SCHED_TIME t2) {
     /*
         INTRODUCTION:
-            Displays GANTT chart scheduling output.
+            Computes the time processes ran in a time window, in O(log n).
 
         INPUT PARAMETERS:
-            - ghead (GANTT*): pointer to GANTT chart head.
-
-        OUTPUT PARAMETERS:
-            - Prints GANTT chart to console.
+            - index (GANTT_INDEX*): indexed chart.
+            - t1, t2 (SCHED_TIME): window [t1, t2).
 
         RETURN VALUES:
-            - None.
+            - (SCHED_TIME): process time in the window (IDLE and context switches are not counted).
 
         APPROACH:
-            - Traverse linked list and print PID, start and finish times.
+            - Difference of the process time before t2 and before t1, each one is the running sum
+              of the entries finished by then plus the part of the entry running at that time.
     */
 
-    if(!ghead) {
-        printf("\nCannot read GANTT chart!\n");
-        return;
-    }
-
-    printf("\nGant Chart:-");
-    printf("\nStart\tPID\tFinish\n------------------------");
-    GANTT *gnew = ghead;
-    while(gnew != NULL)
-    {
-        if(gnew->pid == -1)
-            printf("\n%d\tIDLE\t%d\t", gnew->start_time, gnew->finish_time);
-        else
-            printf("\n%d\tP%d\t%d", gnew->start_time, gnew->pid, gnew->finish_time);
-
-        gnew = gnew->next;
-    }
-    printf("\n----------------------------------------------------------------\n");
+    if(t2 <= t1) return 0;
+    return indexBusyBefore(index, indexFirstAfter(index, t2), t2) - indexBusyBefore(index, indexFirstAfter(index, t1), t1);
 }
 
-void destroyGantt(GANTT *ghead) {
+int ganttUtilization(GANTT_INDEX *index, SCHED_TIME t0, SCHED_TIME width, int buckets, double *util) {
     /*
         INTRODUCTION:
-            Frees allocated memory for GANTT chart.
+            Computes the CPU utilization of consecutive, equally long time buckets.
 
         INPUT PARAMETERS:
-            - ghead (GANTT*): pointer to GANTT chart head.
+            - index (GANTT_INDEX*): indexed chart.
+            - t0 (SCHED_TIME): start of the first bucket.
+            - width (SCHED_TIME): length of every bucket.
+            - buckets (int): number of buckets.
 
         OUTPUT PARAMETERS:
-            - Frees dynamically allocated memory.
+            - util (double*): util[b] is the fraction of [t0 + b*width, t0 + (b+1)*width) processes ran.
 
         RETURN VALUES:
-            - None.
+            - (int): 0 on success, -1 if any error.
 
         APPROACH:
-            - Traverse linked list and free each node using free().
+            - The bucket edges are increasing, so the entry running at each edge is found by walking
+              forward from the previous one instead of a binary search: one pass over the edges and
+              the entries they cross.
+            - The process time before every edge is stored, the last loop only subtracts neighbours
+              and has no branches, so the compiler can vectorize it.
     */
 
-    GANTT *gcurr = ghead;
-    while(ghead) {
-        gcurr = ghead;
-        ghead = ghead->next;
-        free(gcurr);
+    if(!index || !util || width <= 0 || buckets < 1) {
+        printf("\nInvalid utilization buckets!\n");
+        return -1;
+    }
+
+    SCHED_TIME *before = (SCHED_TIME *)malloc((buckets+1)*sizeof(SCHED_TIME));
+    long long i = indexFirstAfter(index, t0);
+    for(int b = 0; b <= buckets; b++) {
+        SCHED_TIME edge = t0 + (SCHED_TIME)b * width;
+        while(i < index->count && index->finish[i] <= edge) i++;
+        before[b] = indexBusyBefore(index, i, edge);
     }
+
+    double scale = 1.0 / width;
+    for(int b = 0; b < buckets; b++) util[b] = (before[b+1] - before[b]) * scale;
+    free(before);
+    return 0;
+}
+
+void destroyGanttIndex(GANTT_INDEX *index) {
+    // Frees a time-window index
+    if(!index) return;
+    free(index->start);
+    free(index->finish);
+    free(index->pid);
+    free(index->busy);
+    free(index);
 }
 
 #endif          // SCHEDULER_H
\ No newline at end of file
@@ -0,0 +1,91 @@
+// Program to run the CPU scheduling algorithms on many independent workloads in one invocation
+
+#include "Schedule.h"
+#include<time.h>
+
+int main(int argc, char *argv[]) {
+
+    /*
+        Usage: batch <file> [algorithm number | all] [time slice] [threads]
+        Algorithms are numbered 0-8 in the order of policyNames, default is all of them,
+        time slice defaults to 4, threads to one per CPU the process may run on.
+        One tab separated line is written per workload and algorithm.
+    */
+
+    if(argc < 2) {
+        printf("\nUsage: %s <file> [algorithm number | all] [time slice] [threads]\n", argv[0]);
+        return 1;
+    }
+
+    int policy[POLICY_COUNT], n_policy = 0;
+    if(argc > 2 && strcmp(argv[2], "all") != 0) {
+        int p = atoi(argv[2]);
+        if(p < 0 || p >= POLICY_COUNT) {
+            printf("\nInvalid algorithm number!\n");
+            return 1;
+        }
+        policy[n_policy++] = p;
+    }
+    else {
+        for(int p = 0; p < POLICY_COUNT; p++) policy[n_policy++] = p;
+    }
+
+    SCHED_TIME time_slice = (argc > 3) ? atoi(argv[3]) : 4;
+    if(time_slice <= 0) {
+        printf("\nInvalid value of Time Slice!\n");
+        return 1;
+    }
+
+    PROCESS *process = NULL;
+    int *offset = NULL;
+    int count = getBatchFile(argv[1], &process, &offset);
+    if(count < 1) return 1;
+
+    POOL *pool = createPool((argc > 4) ? atoi(argv[4]) : 0, 1);
+    if(!pool) return 1;
+
+    int jobs = count * n_policy;
+    JOB *job = (JOB *)calloc(jobs, sizeof(JOB));
+    SCHED_SUMMARY *result = (SCHED_SUMMARY *)malloc(jobs*sizeof(SCHED_SUMMARY));
+
+    struct timespec start, finish;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for(int j = 0; j < jobs; j++) {
+        int k = j / n_policy;
+        job[j].policy = (SCHED_POLICY)policy[j % n_policy];
+        job[j].process = process + offset[k];
+        job[j].n = offset[k+1] - offset[k];
+        job[j].time_slice = time_slice;
+        job[j].summary = &result[j];            // statistics only, no GANTT chart is built
+        poolSubmit(pool, &job[j]);
+    }
+    poolWait(pool);
+
+    clock_gettime(CLOCK_MONOTONIC, &finish);
+
+    printf("Workload\tAlgorithm\tn\tAvgWait\tAvgTAT\tMakespan\tCPU%%\tEntries\n");
+    for(int j = 0; j < jobs; j++) {
+        SCHED_SUMMARY *sum = &result[j];
+        printf("%d\t%s\t%d\t%.2f\t%.2f\t" TIME_FMT "\t%.1f\t%lld\n", j / n_policy, policyNames[job[j].policy],
+            job[j].n, sum->avg_wait, sum->avg_tat, sum->makespan,
+            sum->makespan > 0 ? 100.0*sum->busy/sum->makespan : 0.0, sum->entries);
+    }
+
+    fprintf(stderr, "%d workloads x %d algorithms on %d threads: %.2f ms\n", count, n_policy, pool->n_workers,
+        (finish.tv_sec - start.tv_sec)*1e3 + (finish.tv_nsec - start.tv_nsec)/1e6);
+#ifdef SCHED_STATS
+    SCHED_COUNTERS c;                               // on stderr, stdout stays a plain table
+    getSchedStats(&c);
+    fprintf(stderr, "runs %lld, dispatches %lld, preemptions %lld, comparisons %lld, GANTT entries %lld (%lld merged), "
+        "IDLE segments %lld, sort %.2f ms, simulate %.2f ms\n", c.runs, c.dispatches, c.preemptions, c.comparisons,
+        c.gantt_allocated, c.gantt_merged, c.idle_segments, c.sort_ms, c.simulate_ms);
+#endif
+
+    destroyPool(pool);
+    free(job);
+    free(result);
+    free(process);
+    free(offset);
+    return 0;
+}
@@ -0,0 +1,204 @@
+// Program to benchmark the CPU scheduling algorithms on generated workloads
+
+#include "Schedule.h"
+#include<time.h>
+#include<unistd.h>
+#include<sys/ioctl.h>
+#include<sys/syscall.h>
+#include<linux/perf_event.h>
+
+#define PERF_EVENTS 4                               // cycles, instructions, cache misses, branch misses
+
+typedef struct perfcounters
+{
+    /*
+        INTRODUCTION:
+            Structure to represent a group of hardware counters opened with perf_event_open.
+
+        VARIABLES:
+            - fd (int[]):               File descriptors, fd[0] is the group leader (-1 if not opened).
+            - value (long long[]):      Counts of the last measurement, in the order of perfNames.
+    */
+
+    int fd[PERF_EVENTS];
+    long long value[PERF_EVENTS];
+}PERF_COUNTERS;
+
+const char *perfNames[PERF_EVENTS] = {"cycles", "instructions", "cache-misses", "branch-misses"};
+
+double elapsedMs(struct timespec start, struct timespec finish) {
+    // Milliseconds between two CLOCK_MONOTONIC readings
+    return (finish.tv_sec - start.tv_sec)*1e3 + (finish.tv_nsec - start.tv_nsec)/1e6;
+}
+
+void generateWorkload(PROCESS *process, int n, unsigned int seed) {
+    /*
+        INTRODUCTION:
+            Fills a process array with a reproducible random workload.
+
+        INPUT PARAMETERS:
+            - process (PROCESS*): process array.
+            - n (int): number of processes.
+            - seed (unsigned int): random seed.
+
+        OUTPUT PARAMETERS:
+            - Fills process.
+
+        RETURN VALUES:
+            - None.
+
+        APPROACH:
+            - Arrivals spread over about half of the total burst time so the ready queue builds up,
+              bursts 1-20, priorities 0-9.
+    */
+
+    srand(seed);
+    for(int i = 0; i < n; i++) {
+        process[i].pid = i;
+        process[i].arrive_time = rand() % (5*n + 1);
+        process[i].burst_time = process[i].initial_burst = 1 + rand() % 20;
+        process[i].priority = rand() % 10;
+    }
+}
+
+int perfOpen(PERF_COUNTERS *perf) {
+    /*
+        INTRODUCTION:
+            Opens the hardware counters of the calling thread as one group.
+
+        INPUT PARAMETERS:
+            - perf (PERF_COUNTERS*): counters to open.
+
+        OUTPUT PARAMETERS:
+            - Fills the file descriptors, the counters start disabled.
+
+        RETURN VALUES:
+            - (int): 0 on success, -1 if the counters are not available (no PMU, container,
+              perf_event_paranoid too high); nothing is left open then.
+
+        APPROACH:
+            - Count user space only, so the benchmark works with perf_event_paranoid <= 2.
+            - One group: all four counters run over exactly the same instructions.
+    */
+
+    unsigned long long config[PERF_EVENTS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+    for(int k = 0; k < PERF_EVENTS; k++) perf->fd[k] = -1;
+    for(int k = 0; k < PERF_EVENTS; k++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config[k];
+        attr.disabled = (k == 0);                   // members follow the leader
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        perf->fd[k] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, (k == 0) ? -1 : perf->fd[0], 0);
+        if(perf->fd[k] < 0) {
+            for(int j = 0; j < k; j++) close(perf->fd[j]);
+            perf->fd[0] = -1;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void perfStart(PERF_COUNTERS *perf) {
+    // Resets and enables the group
+    ioctl(perf->fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(perf->fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void perfStop(PERF_COUNTERS *perf) {
+    // Disables the group and reads every counter
+    ioctl(perf->fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    for(int k = 0; k < PERF_EVENTS; k++) {
+        long long count = 0;
+        if(read(perf->fd[k], &count, sizeof(count)) != sizeof(count)) count = 0;
+        perf->value[k] = count;
+    }
+}
+
+void perfClose(PERF_COUNTERS *perf) {
+    for(int k = 0; k < PERF_EVENTS; k++)
+        if(perf->fd[k] >= 0) close(perf->fd[k]);
+}
+
+int main(int argc, char *argv[]) {
+
+    /*
+        Usage: benchmark [--perf] [--stats] [number of processes ...]
+        Every algorithm is run on the same generated workload for every size,
+        the best of 5 runs is reported.
+        --stats times getStatsPolicy (statistics only, no GANTT chart) instead of getGanttPolicy.
+        --perf also reports hardware counters of the best run (perf_event_open):
+        instructions per cycle, cache and branch misses per process.
+    */
+
+    int sizes[16] = {1000, 4000}, n_sizes = 2, use_perf = 0, stats_only = 0, given = 0;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--perf") == 0) use_perf = 1;
+        else if(strcmp(argv[i], "--stats") == 0) stats_only = 1;
+        else if(atoi(argv[i]) > 0 && given < 16) sizes[given++] = atoi(argv[i]);
+    }
+    if(given > 0) n_sizes = given;
+
+    PERF_COUNTERS perf;
+    if(use_perf && perfOpen(&perf) != 0) {
+        printf("\nHardware counters are not available (perf_event_open failed), timing only.\n");
+        use_perf = 0;
+    }
+
+    printf("\nAlgorithm\t\tProcesses\tms");
+    if(use_perf) printf("\tIPC\tcache-miss/proc\tbranch-miss/proc");
+    printf("\n------------------------------------------------");
+    if(use_perf) printf("------------------------------------------------");
+
+    for(int s = 0; s < n_sizes; s++) {
+        int n = sizes[s];
+        PROCESS *workload = (PROCESS *)malloc(n*sizeof(PROCESS));
+        PROCESS *process = (PROCESS *)malloc(n*sizeof(PROCESS));
+        generateWorkload(workload, n, 42);
+
+        for(int policy = 0; policy < POLICY_COUNT; policy++) {
+            double best = -1;
+            long long counts[PERF_EVENTS] = {0};
+            for(int run = 0; run < 5; run++) {
+                struct timespec start, finish;
+                memcpy(process, workload, n*sizeof(PROCESS));
+
+                if(use_perf) perfStart(&perf);
+                clock_gettime(CLOCK_MONOTONIC, &start);
+                GANTT *gantt = NULL;
+                SCHED_SUMMARY sum;
+                if(stats_only) getStatsPolicy((SCHED_POLICY)policy, process, n, 4, &sum);
+                else gantt = getGanttPolicy((SCHED_POLICY)policy, process, n, 4);
+                clock_gettime(CLOCK_MONOTONIC, &finish);
+                if(use_perf) perfStop(&perf);
+
+                destroyGantt(gantt);
+                double ms = elapsedMs(start, finish);
+                if(best < 0 || ms < best) {
+                    best = ms;
+                    if(use_perf) memcpy(counts, perf.value, sizeof(counts));
+                }
+            }
+            printf("\n%-24s%d\t\t%.2f", policyNames[policy], n, best);
+            if(use_perf)
+                printf("\t%.2f\t%.2f\t\t%.2f", counts[0] ? (double)counts[1]/counts[0] : 0.0,
+                    (double)counts[2]/n, (double)counts[3]/n);
+        }
+        free(workload);
+        free(process);
+    }
+    printf("\n------------------------------------------------");
+    if(use_perf) printf("------------------------------------------------");
+    printf("\n");
+    if(use_perf) perfClose(&perf);
+#ifdef SCHED_STATS
+    displaySchedStats();
+#endif
+    return 0;
+}
@@ -0,0 +1,494 @@
+// Program to compare optimized scheduler implementations against the reference getGantt* functions
+
+#include "Schedule.h"
+#include<time.h>
+
+#define MAX_PROCESSES 12
+
+/*
+    Every variant runs a workload once with the reference implementation and once with the candidate,
+    the GANTT charts and the wait / turnaround time of every pid must be identical.
+    A runner schedules process[0..n-1] in place, rng drives any randomness of the candidate
+    (e.g. how far the online scheduler advances at a time) so a case replays exactly from its seed.
+*/
+typedef GANTT* (*RUNNER)(SCHED_POLICY, PROCESS *, int, SCHED_TIME, unsigned int *);
+
+typedef struct variant
+{
+    /*
+        INTRODUCTION:
+            Structure to represent one reference / candidate pair.
+
+        VARIABLES:
+            - name (char*):             Name used in the report and with -v.
+            - policy (SCHED_POLICY):    Algorithm passed to both runners.
+            - reference (RUNNER):       Reference implementation.
+            - candidate (RUNNER):       Implementation under test.
+            - distinct (int):           Non-zero if arrival times must be distinct (the reference breaks
+                                        ties of equal arrivals with an unstable sort).
+    */
+
+    const char *name;
+    SCHED_POLICY policy;
+    RUNNER reference, candidate;
+    int distinct;
+}VARIANT;
+
+unsigned int nextRandom(unsigned int *state) {
+    // xorshift32, never returns 0 for a non-zero state
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+GANTT* runReference(SCHED_POLICY policy, PROCESS *process, int n, SCHED_TIME time_slice, unsigned int *rng) {
+    return getGanttPolicy(policy, process, n, time_slice);
+}
+
+#define WHEEL_OFFSET ((1 << 20) - 7)        // shifted arrivals cross 2^20: the timing wheel cascades from level 3
+
+GANTT* runScheduler(SCHED_POLICY policy, PROCESS *process, int n, SCHED_TIME time_slice, unsigned int *rng,
+                    EVENTQ_KIND kind, SCHED_TIME offset, int resume, int lazy) {
+    // Incremental scheduler with the given arrival queue, arrivals shifted by offset and shifted back afterwards,
+    // if resume is non-zero it is saved to a checkpoint and restored from it after about every other step,
+    // if lazy is non-zero every process is submitted only once the scheduler has reached its arrival
+    int order[MAX_PROCESSES];                       // submission order, by arrival if lazy
+    for(int i = 0; i < n; i++) {
+        int k = i;
+        for(; lazy && k > 0 && process[order[k-1]].arrive_time > process[i].arrive_time; k--) order[k] = order[k-1];
+        order[k] = i;
+    }
+
+    SCHEDULER *s = createScheduler(policy, time_slice);
+    schedulerUseEventQueue(s, kind);
+    int next = 0;
+
+    GANTT *ghead = NULL, *gcurr = NULL;
+    SCHED_TIME time = offset;
+    while(s->completed < n) {
+        while(next < n && (!lazy || process[order[next]].arrive_time + offset <= s->curr_time)) {
+            PROCESS p = process[order[next++]];
+            p.arrive_time += offset;
+            schedulerSubmit(s, p);
+        }
+
+        time += 1 + nextRandom(rng) % 5;
+        if(next < n && process[order[next]].arrive_time + offset < time) time = process[order[next]].arrive_time + offset;
+        schedulerAdvanceTo(s, time);
+
+        if(resume && nextRandom(rng) % 2) {
+            FILE *fptr = tmpfile();
+            schedulerSaveFile(s, fptr);
+            destroyScheduler(s);
+            rewind(fptr);
+            s = schedulerLoadFile(fptr);
+            fclose(fptr);
+        }
+
+        GANTT *segments = schedulerPollSegments(s);
+        if(!segments) continue;
+        if(!ghead) ghead = segments;
+        else gcurr->next = segments;
+        for(gcurr = segments; gcurr->next; gcurr = gcurr->next);
+    }
+
+    for(GANTT *g = ghead; g; g = g->next) {
+        g->start_time -= offset;
+        g->finish_time -= offset;
+    }
+    if(ghead && ghead->pid == -1 && ghead->start_time < 0) {     // IDLE from time 0, before the first arrival
+        ghead->start_time = 0;
+        if(ghead->finish_time == 0) {
+            GANTT *empty = ghead;
+            ghead = ghead->next;
+            schedFree(empty);
+        }
+    }
+    for(int k = 0; k < n; k++) {
+        process[order[k]] = s->process[k];
+        process[order[k]].arrive_time -= offset;
+    }
+    destroyScheduler(s);
+    return ghead;
+}
+
+GANTT* runOnline(SCHED_POLICY policy, PROCESS *process, int n, SCHED_TIME time_slice, unsigned int *rng) {
+    // Incremental scheduler, advanced by random steps of 1-5 time units and polled after every step
+    return runScheduler(policy, process, n, time_slice, rng, EVENTQ_AUTO, 0, 0, 0);
+}
+
+GANTT* runOnlineHeap(SCHED_POLICY policy, PROCESS *process, int n, SCHED_TIME time_slice, unsigned int *rng) {
+    // Incremental scheduler with a heap of arrivals
+    return runScheduler(policy, process, n, time_slice, rng, EVENTQ_HEAP, 0, 0, 0);
+}
+
+GANTT* runOnlineWheel(SCHED_POLICY policy, PROCESS *process, int n, SCHED_TIME time_slice, unsigned int *rng) {
+    // Incremental scheduler with a timing wheel of arrivals, far from time 0 (the IDLE entry from 0 is kept)
+    return runScheduler(policy, process, n, time_slice, rng, EVENTQ_WHEEL, WHEEL_OFFSET, 0, 0);
+}
+
+GANTT* runResumed(SCHED_POLICY policy, PROCESS *process, int n, SCHED_TIME time_slice, unsigned int *rng) {
+    // Incremental scheduler restored from a checkpoint between steps
+    return runScheduler(policy, process, n, time_slice, rng, EVENTQ_AUTO, 0, 1, 0);
+}
+
+GANTT* runResumedWheel(SCHED_POLICY policy, PROCESS *process, int n, SCHED_TIME time_slice, unsigned int *rng) {
+    // Same with a timing wheel of arrivals, which is saved as a list of indices and filled again
+    return runScheduler(policy, process, n, time_slice, rng, EVENTQ_WHEEL, WHEEL_OFFSET, 1, 0);
+}
+
+GANTT* runLazy(SCHED_POLICY policy, PROCESS *process, int n, SCHED_TIME time_slice, unsigned int *rng) {
+    // Incremental scheduler fed as processes arrive: each one is submitted after advancing to its arrival
+    return runScheduler(policy, process, n, time_slice, rng, EVENTQ_AUTO, 0, 0, 1);
+}
+
+GANTT* runAgingOff(SCHED_POLICY policy, PROCESS *process, int n, SCHED_TIME time_slice, unsigned int *rng) {
+    // Priority with aging disabled must behave exactly like plain Priority
+    if(policy == POLICY_PRIORITY) return getGanttPriorityAging(process, n, 0);
+    return getGanttPriorityPreemptiveAging(process, n, 0);
+}
+
+GANTT* runArena(SCHED_POLICY policy, PROCESS *process, int n, SCHED_TIME time_slice, unsigned int *rng) {
+    // Reference built in a scratch arena, copied out so the caller can free it with destroyGantt
+    ARENA arena;
+    arenaInit(&arena, 256);
+    useArena(&arena);
+    GANTT *gantt = getGanttPolicy(policy, process, n, time_slice);
+    useArena(NULL);
+
+    GANTT *ghead = ganttCopy(gantt);
+    arenaDestroy(&arena);
+    return ghead;
+}
+
+GANTT* runBuffered(SCHED_POLICY policy, PROCESS *process, int n, SCHED_TIME time_slice, unsigned int *rng) {
+    // Chart in a GANTT_BUFFER, copied out so the caller can free it with destroyGantt
+    GANTT_BUFFER buf;
+    ganttBufferInit(&buf);
+    GANTT *gantt = getGanttBuffered(policy, process, n, &buf);
+
+    GANTT *ghead = ganttCopy(gantt);
+    ganttBufferDestroy(&buf);
+    return ghead;
+}
+
+GANTT* runOneCore(SCHED_POLICY policy, PROCESS *process, int n, SCHED_TIME time_slice, unsigned int *rng) {
+    // A single speed 1 core of the heterogeneous multiprocessor must behave like the algorithm itself
+    CPU_CORE core = {1.0, 1.0};
+    GANTT **gantt = getGanttCores(process, n, policy, time_slice, &core, 1, PLACE_FASTEST_FREE, NULL);
+    GANTT *ghead = gantt[0];
+    free(gantt);
+    return ghead;
+}
+
+GANTT* runCompressed(SCHED_POLICY policy, PROCESS *process, int n, SCHED_TIME time_slice, unsigned int *rng) {
+    // Compressed Gantt chart, decoded again
+    GANTT_RLE *rle = getGanttCompressed(policy, process, n, time_slice);
+    GANTT *ghead = ganttDecompress(rle);
+    destroyGanttRLE(rle);
+    return ghead;
+}
+
+VARIANT variants[] = {
+    {"online-fcfs", POLICY_FCFS, runReference, runOnline, 1},
+    {"online-sjf", POLICY_SJF, runReference, runOnline, 1},
+    {"online-hrrn", POLICY_HRRN, runReference, runOnline, 1},
+    {"online-priority", POLICY_PRIORITY, runReference, runOnline, 1},
+    {"online-ljf", POLICY_LJF, runReference, runOnline, 1},
+    {"online-srtf", POLICY_SRTF, runReference, runOnline, 1},
+    {"online-priority-preemptive", POLICY_PRIORITY_PREEMPTIVE, runReference, runOnline, 1},
+    {"online-lrtf", POLICY_LRTF, runReference, runOnline, 1},
+    {"online-round-robin", POLICY_ROUND_ROBIN, runReference, runOnline, 1},
+    {"lazy-fcfs", POLICY_FCFS, runReference, runLazy, 1},
+    {"lazy-sjf", POLICY_SJF, runReference, runLazy, 1},
+    {"lazy-hrrn", POLICY_HRRN, runReference, runLazy, 1},
+    {"lazy-priority", POLICY_PRIORITY, runReference, runLazy, 1},
+    {"lazy-ljf", POLICY_LJF, runReference, runLazy, 1},
+    {"lazy-srtf", POLICY_SRTF, runReference, runLazy, 1},
+    {"lazy-priority-preemptive", POLICY_PRIORITY_PREEMPTIVE, runReference, runLazy, 1},
+    {"lazy-lrtf", POLICY_LRTF, runReference, runLazy, 1},
+    {"lazy-round-robin", POLICY_ROUND_ROBIN, runReference, runLazy, 1},
+    {"wheel-fcfs", POLICY_FCFS, runOnlineHeap, runOnlineWheel, 0},
+    {"wheel-sjf", POLICY_SJF, runOnlineHeap, runOnlineWheel, 0},
+    {"wheel-hrrn", POLICY_HRRN, runOnlineHeap, runOnlineWheel, 0},
+    {"wheel-srtf", POLICY_SRTF, runOnlineHeap, runOnlineWheel, 0},
+    {"wheel-priority-preemptive", POLICY_PRIORITY_PREEMPTIVE, runOnlineHeap, runOnlineWheel, 0},
+    {"wheel-lrtf", POLICY_LRTF, runOnlineHeap, runOnlineWheel, 0},
+    {"wheel-round-robin", POLICY_ROUND_ROBIN, runOnlineHeap, runOnlineWheel, 0},
+    {"checkpoint-fcfs", POLICY_FCFS, runReference, runResumed, 1},
+    {"checkpoint-hrrn", POLICY_HRRN, runReference, runResumed, 1},
+    {"checkpoint-srtf", POLICY_SRTF, runReference, runResumed, 1},
+    {"checkpoint-lrtf", POLICY_LRTF, runReference, runResumed, 1},
+    {"checkpoint-round-robin", POLICY_ROUND_ROBIN, runReference, runResumed, 1},
+    {"checkpoint-wheel-srtf", POLICY_SRTF, runOnlineHeap, runResumedWheel, 0},
+    {"checkpoint-wheel-round-robin", POLICY_ROUND_ROBIN, runOnlineHeap, runResumedWheel, 0},
+    {"aging-off-priority", POLICY_PRIORITY, runReference, runAgingOff, 0},
+    {"aging-off-priority-preemptive", POLICY_PRIORITY_PREEMPTIVE, runReference, runAgingOff, 0},
+    {"arena-srtf", POLICY_SRTF, runReference, runArena, 0},
+    {"arena-round-robin", POLICY_ROUND_ROBIN, runReference, runArena, 0},
+    {"buffered-fcfs", POLICY_FCFS, runReference, runBuffered, 0},
+    {"buffered-sjf", POLICY_SJF, runReference, runBuffered, 0},
+    {"buffered-hrrn", POLICY_HRRN, runReference, runBuffered, 0},
+    {"buffered-priority", POLICY_PRIORITY, runReference, runBuffered, 0},
+    {"buffered-ljf", POLICY_LJF, runReference, runBuffered, 0},
+    {"cores-fcfs", POLICY_FCFS, runReference, runOneCore, 0},
+    {"cores-sjf", POLICY_SJF, runReference, runOneCore, 0},
+    {"cores-hrrn", POLICY_HRRN, runReference, runOneCore, 0},
+    {"cores-priority", POLICY_PRIORITY, runReference, runOneCore, 0},
+    {"cores-ljf", POLICY_LJF, runReference, runOneCore, 0},
+    {"cores-srtf", POLICY_SRTF, runReference, runOneCore, 0},
+    {"cores-priority-preemptive", POLICY_PRIORITY_PREEMPTIVE, runReference, runOneCore, 0},
+    {"cores-lrtf", POLICY_LRTF, runReference, runOneCore, 0},
+    {"cores-round-robin", POLICY_ROUND_ROBIN, runReference, runOneCore, 0},
+    {"compressed-srtf", POLICY_SRTF, runReference, runCompressed, 0},
+    {"compressed-priority-preemptive", POLICY_PRIORITY_PREEMPTIVE, runReference, runCompressed, 0},
+    {"compressed-lrtf", POLICY_LRTF, runReference, runCompressed, 0},
+    {"compressed-round-robin", POLICY_ROUND_ROBIN, runReference, runCompressed, 0},
+};
+#define N_VARIANTS ((int)(sizeof(variants)/sizeof(variants[0])))
+
+typedef struct testcase
+{
+    /*
+        INTRODUCTION:
+            Structure to represent one generated workload.
+
+        VARIABLES:
+            - process (PROCESS[]):      Processes, pid i at index i.
+            - n (int):                  Number of processes.
+            - time_slice (SCHED_TIME):  Time quantum for Round Robin.
+            - rng (unsigned int):       Seed of the candidate's randomness.
+    */
+
+    PROCESS process[MAX_PROCESSES];
+    int n;
+    SCHED_TIME time_slice;
+    unsigned int rng;
+}TESTCASE;
+
+void generateCase(TESTCASE *t, unsigned int seed, int distinct) {
+    /*
+        INTRODUCTION:
+            Generates a random workload from a seed.
+
+        INPUT PARAMETERS:
+            - t (TESTCASE*): case to fill.
+            - seed (unsigned int): seed of the case, printed on failure to replay it.
+            - distinct (int): non-zero for distinct arrival times.
+
+        APPROACH:
+            - 1-12 processes, bursts 1-8, priorities 0-3, time slice 1-4.
+            - Arrivals are drawn from a small range (0-15) so IDLE gaps, ties and preemptions are common;
+              distinct arrivals are a random subset of 0-23 in random order.
+    */
+
+    unsigned int rng = seed ? seed : 1;
+    for(int k = 0; k < 4; k++) nextRandom(&rng);
+
+    t->n = 1 + nextRandom(&rng) % MAX_PROCESSES;
+    t->time_slice = 1 + nextRandom(&rng) % 4;
+
+    int used[24] = {0};
+    for(int i = 0; i < t->n; i++) {
+        PROCESS *p = &t->process[i];
+        p->pid = i;
+        if(distinct) {
+            int a;
+            do a = nextRandom(&rng) % 24; while(used[a]);
+            used[a] = 1;
+            p->arrive_time = a;
+        }
+        else p->arrive_time = nextRandom(&rng) % 16;
+        p->burst_time = p->initial_burst = 1 + nextRandom(&rng) % 8;
+        p->priority = nextRandom(&rng) % 4;
+        p->wait_time = p->turnaround_time = 0;
+    }
+    t->rng = nextRandom(&rng) | 1;
+}
+
+int compareRuns(VARIANT *v, TESTCASE *t, int verbose) {
+    /*
+        INTRODUCTION:
+            Runs both implementations of a variant on a case.
+
+        INPUT PARAMETERS:
+            - v (VARIANT*): variant to check.
+            - t (TESTCASE*): workload (not modified).
+            - verbose (int): non-zero to print both schedules.
+
+        RETURN VALUES:
+            - (int): 1 if the results are identical, 0 otherwise.
+    */
+
+    PROCESS ref[MAX_PROCESSES], cand[MAX_PROCESSES];
+    memcpy(ref, t->process, t->n*sizeof(PROCESS));
+    memcpy(cand, t->process, t->n*sizeof(PROCESS));
+
+    unsigned int rng_ref = t->rng, rng_cand = t->rng;
+    GANTT *gref = v->reference(v->policy, ref, t->n, t->time_slice, &rng_ref);
+    GANTT *gcand = v->candidate(v->policy, cand, t->n, t->time_slice, &rng_cand);
+
+    int same = 1;
+    GANTT *a = gref, *b = gcand;
+    for(; a && b; a = a->next, b = b->next)
+        if(a->pid != b->pid || a->start_time != b->start_time || a->finish_time != b->finish_time) same = 0;
+    if(a || b) same = 0;
+
+    SCHED_TIME wait[MAX_PROCESSES], tat[MAX_PROCESSES];      // runners may reorder the array, compare by pid
+    for(int i = 0; i < t->n; i++) {
+        wait[ref[i].pid] = ref[i].wait_time;
+        tat[ref[i].pid] = ref[i].turnaround_time;
+    }
+    for(int i = 0; i < t->n; i++)
+        if(wait[cand[i].pid] != cand[i].wait_time || tat[cand[i].pid] != cand[i].turnaround_time) same = 0;
+
+    if(verbose) {
+        printf("\nReference:");
+        displayGantt(gref);
+        displayProcesses(ref, t->n);
+        printf("\nCandidate:");
+        displayGantt(gcand);
+        displayProcesses(cand, t->n);
+    }
+
+    destroyGantt(gref);
+    destroyGantt(gcand);
+    return same;
+}
+
+void shrinkCase(VARIANT *v, TESTCASE *t) {
+    /*
+        INTRODUCTION:
+            Reduces a failing case to a small one that still fails.
+
+        INPUT PARAMETERS:
+            - v (VARIANT*): failing variant.
+            - t (TESTCASE*): failing case, replaced by the reduced case.
+
+        APPROACH:
+            - Repeat until nothing changes: drop one process (pids are renumbered), then lower every
+              arrival, burst, priority and the time slice, first to the smallest value, then by one.
+            - A change is kept only if the case still fails (and keeps distinct arrivals if required).
+    */
+
+    int changed = 1;
+    while(changed) {
+        changed = 0;
+
+        for(int i = 0; i < t->n && t->n > 1; i++) {
+            TESTCASE c = *t;
+            for(int k = i; k < c.n-1; k++) {
+                c.process[k] = c.process[k+1];
+                c.process[k].pid = k;
+            }
+            c.n--;
+            if(!compareRuns(v, &c, 0)) {
+                *t = c;
+                changed = 1;
+                i--;
+            }
+        }
+
+        for(int i = 0; i < t->n; i++) {
+            for(int field = 0; field < 3; field++) {
+                SCHED_TIME *value = (field == 0) ? &t->process[i].arrive_time : &t->process[i].burst_time;
+                int smallest = (field == 1) ? 1 : 0;
+                for(int step = 0; step < 2; step++) {
+                    TESTCASE c = *t;
+                    PROCESS *p = &c.process[i];
+                    if(field == 2) {
+                        if(p->priority <= 0) break;
+                        p->priority = step ? p->priority-1 : 0;
+                    }
+                    else {
+                        SCHED_TIME *cv = (field == 0) ? &p->arrive_time : &p->burst_time;
+                        if(*value <= smallest) break;
+                        *cv = step ? *value-1 : smallest;
+                        p->initial_burst = p->burst_time;
+                    }
+
+                    int clash = 0;
+                    for(int k = 0; v->distinct && k < c.n; k++)
+                        if(k != i && c.process[k].arrive_time == p->arrive_time) clash = 1;
+                    if(!clash && !compareRuns(v, &c, 0)) {
+                        *t = c;
+                        changed = 1;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if(t->time_slice > 1) {
+            TESTCASE c = *t;
+            c.time_slice--;
+            if(!compareRuns(v, &c, 0)) {
+                *t = c;
+                changed = 1;
+            }
+        }
+    }
+}
+
+void reportFailure(VARIANT *v, TESTCASE *t, unsigned int seed) {
+    // Prints the seed to replay the case, the shrunk workload and both schedules
+    printf("\nFAIL %s, replay with: difftest -v %s -r %u\n", v->name, v->name, seed);
+    shrinkCase(v, t);
+    printf("\nShrunk case (time slice " TIME_FMT ", candidate seed %u):\n%d\n", t->time_slice, t->rng, t->n);
+    for(int i = 0; i < t->n; i++)
+        printf(TIME_FMT " " TIME_FMT " %d\n", t->process[i].arrive_time, t->process[i].burst_time, t->process[i].priority);
+    compareRuns(v, t, 1);
+}
+
+int main(int argc, char *argv[]) {
+
+    /*
+        Usage: difftest [-n cases] [-s seed] [-v variant] [-r case seed]
+        Runs every variant (or only -v) on cases generated from seed (default: current time),
+        -r replays a single case. Stops a variant at its first failure, shrinks and prints it.
+        Returns 1 if any variant failed.
+    */
+
+    long long cases = 100000;
+    unsigned int seed = (unsigned int)time(NULL), replay = 0;
+    const char *only = NULL;
+
+    for(int i = 1; i+1 < argc; i += 2) {
+        if(strcmp(argv[i], "-n") == 0) cases = atoll(argv[i+1]);
+        else if(strcmp(argv[i], "-s") == 0) seed = (unsigned int)strtoul(argv[i+1], NULL, 10);
+        else if(strcmp(argv[i], "-v") == 0) only = argv[i+1];
+        else if(strcmp(argv[i], "-r") == 0) replay = (unsigned int)strtoul(argv[i+1], NULL, 10);
+        else {
+            printf("\nUnknown option %s!\n", argv[i]);
+            return 1;
+        }
+    }
+
+    printf("\nSeed: %u\n", seed);
+    printf("\nVariant\t\t\t\tCases\t\tResult");
+    printf("\n----------------------------------------------------------------");
+
+    int failed = 0;
+    for(int k = 0; k < N_VARIANTS; k++) {
+        VARIANT *v = &variants[k];
+        if(only && strcmp(only, v->name) != 0) continue;
+
+        long long run = 0;
+        int ok = 1;
+        TESTCASE t;
+        for(long long c = 0; c < (replay ? 1 : cases) && ok; c++, run++) {
+            unsigned int case_seed = replay ? replay : seed ^ (unsigned int)(c * 2654435761u) ^ (unsigned int)(k * 40503u);
+            generateCase(&t, case_seed, v->distinct);
+            if(!compareRuns(v, &t, 0)) {
+                ok = 0;
+                failed = 1;
+                reportFailure(v, &t, case_seed);
+            }
+        }
+        printf("\n%-32s%lld\t\t%s", v->name, run, ok ? "ok" : "FAILED");
+    }
+    printf("\n----------------------------------------------------------------\n");
+    return failed;
+}
@@ -0,0 +1,57 @@
+// Program to compare the energy of a schedule under race-to-idle and slow-and-steady DVFS
+
+#include "Schedule.h"
+
+void main() {
+
+    /*
+        **** To take file names input from the user ***
+        char fileName[50], modelFile[50];
+        printf("\nEnter file name: ");
+        scanf("%s", fileName);
+        printf("\nEnter power model file name: ");
+        scanf("%s", modelFile);
+
+    */
+
+    PROCESS *process = NULL;
+    ENERGY_MODEL model;
+    int n = getProcessesFilePriority("input_priority.txt", &process);
+
+    if(n > 0 && getEnergyModelFile("input_energy.txt", &model) > 0) {
+        int policy = -1;
+        do {
+            printf("\nAlgorithms:-");
+            for(int i = 0; i < POLICY_COUNT; i++) printf("\n\t%d. %s", i, policyNames[i]);
+            printf("\nEnter algorithm: ");
+            scanf("%d", &policy);
+            if(policy < 0 || policy >= POLICY_COUNT) printf("\nEnter a valid value!\n");
+        } while(policy < 0 || policy >= POLICY_COUNT);
+
+        int slice = 0;
+        if(policy == POLICY_ROUND_ROBIN) {
+            do {
+                printf("\nEnter time slice: ");
+                scanf("%d", &slice);
+                if(slice <= 0) printf("\nEnter a valid value!\n");
+            } while(slice <= 0);
+        }
+
+        GANTT *gantt = getGanttPolicy((SCHED_POLICY)policy, process, n, slice);
+
+        if(gantt) {
+            displayGantt(gantt);
+            displayProcesses(process, n);
+
+            ENERGY_REPORT report[DVFS_COUNT];
+            int ok = 1;
+            for(int k = 0; k < DVFS_COUNT; k++)
+                if(getEnergy(gantt, process, n, &model, (DVFS_POLICY)k, &report[k]) != 0) ok = 0;
+            if(ok) displayEnergy(report, DVFS_COUNT);
+        }
+
+        destroyGantt(gantt);
+        free(model.state);
+    }
+    destroyProcesses(process);
+}
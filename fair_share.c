@@ -0,0 +1,39 @@
+// Program to simulate hierarchical fair-share scheduling of control groups with CPU bandwidth quotas
+
+#include "Schedule.h"
+
+void main() {
+
+    /*
+        **** To take file name input from the user ***
+        char fileName[50];
+        printf("\nEnter file name: ");
+        scanf("%s", fileName);
+
+    */
+
+    PROCESS *process = NULL;
+    CGROUP *groups = NULL;
+    int *group = NULL, n_groups = 0;
+    int n = getProcessesFileGroups("input_groups.txt", &process, &group, &groups, &n_groups);
+
+    if(n > 0) {
+        int slice = -1;
+        do {
+            printf("\nEnter time slice: ");
+            scanf("%d", &slice);
+            if(slice <= 0) printf("\nEnter a valid value!\n");
+        } while(slice <= 0);
+
+        GANTT *gantt = getGanttGroups(process, n, group, groups, n_groups, slice);
+
+        if(gantt) displayGantt(gantt);
+        displayProcesses(process, n);
+        displayGroups(groups, n_groups, gantt);
+
+        destroyGantt(gantt);
+        destroyProcesses(process);
+        destroyGroups(groups);
+        free(group);
+    }
+}
@@ -0,0 +1,77 @@
+// Program to run the CPU scheduling algorithms on a multiprocessor whose cores have different speeds
+
+#include "Schedule.h"
+
+void main() {
+
+    /*
+        **** To take file names input from the user ***
+        char fileName[50], coreFile[50];
+        printf("\nEnter file name: ");
+        scanf("%s", fileName);
+        printf("\nEnter cores file name: ");
+        scanf("%s", coreFile);
+
+    */
+
+    PROCESS *process = NULL;
+    CPU_CORE *core = NULL;
+    int n = getProcessesFilePriority("input_priority.txt", &process);
+    int n_cores = (n > 0) ? getCoresFile("input_cores.txt", &core) : -1;
+
+    if(n > 0 && n_cores > 0) {
+        int policy = -1;
+        do {
+            printf("\nAlgorithms:-");
+            for(int i = 0; i < POLICY_COUNT; i++) printf("\n\t%d. %s", i, policyNames[i]);
+            printf("\nEnter algorithm: ");
+            scanf("%d", &policy);
+            if(policy < 0 || policy >= POLICY_COUNT) printf("\nEnter a valid value!\n");
+        } while(policy < 0 || policy >= POLICY_COUNT);
+
+        int slice = 0;
+        if(policy == POLICY_ROUND_ROBIN) {
+            do {
+                printf("\nEnter time slice: ");
+                scanf("%d", &slice);
+                if(slice <= 0) printf("\nEnter a valid value!\n");
+            } while(slice <= 0);
+        }
+
+        int placement = -1;
+        do {
+            printf("\nPlacement:-");
+            for(int i = 0; i < PLACE_COUNT; i++) printf("\n\t%d. %s", i, placementNames[i]);
+            printf("\nEnter placement: ");
+            scanf("%d", &placement);
+            if(placement < 0 || placement >= PLACE_COUNT) printf("\nEnter a valid value!\n");
+        } while(placement < 0 || placement >= PLACE_COUNT);
+
+        GANTT **gantt = getGanttCores(process, n, (SCHED_POLICY)policy, slice, core, n_cores, (PLACEMENT)placement, NULL);
+
+        // Baseline: the same number of reference cores (speed 1)
+        PROCESS *baseline = (PROCESS *)malloc(n*sizeof(PROCESS));
+        memcpy(baseline, process, n*sizeof(PROCESS));
+        CPU_CORE *reference = (CPU_CORE *)calloc(n_cores, sizeof(CPU_CORE));
+        for(int c = 0; c < n_cores; c++) reference[c].speed = reference[c].power = 1.0;
+        GANTT **gantt_base = getGanttCores(baseline, n, (SCHED_POLICY)policy, slice, reference, n_cores,
+                                           (PLACEMENT)placement, NULL);
+
+        if(gantt) {
+            for(int c = 0; c < n_cores; c++) {
+                printf("\nCore %d:-", c);
+                if(gantt[c]) displayGantt(gantt[c]);
+                else printf("\nNo processes\n");
+            }
+            displayProcesses(process, n);
+            displayCores(core, n_cores, process, gantt_base ? baseline : NULL, n);
+        }
+
+        destroyGanttCores(gantt, n_cores);
+        destroyGanttCores(gantt_base, n_cores);
+        free(reference);
+        free(baseline);
+    }
+    destroyProcesses(process);
+    if(core) free(core);
+}
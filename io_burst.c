@@ -0,0 +1,49 @@
+// Program to simulate scheduling of processes with alternating CPU and I/O bursts
+
+#include "Schedule.h"
+
+void main() {
+
+    /*
+        **** To take file name input from the user ***
+        char fileName[50];
+        printf("\nEnter file name: ");
+        scanf("%s", fileName);
+
+    */
+
+    IO_PROCESS *process = NULL;
+    int n = getProcessesFileIO("input_io.txt", &process);
+
+    if(n > 0) {
+        int policy = -1;
+        do {
+            printf("\nAlgorithms:-");
+            for(int i = 0; i < POLICY_COUNT; i++) printf("\n\t%d. %s", i, policyNames[i]);
+            printf("\nEnter algorithm: ");
+            scanf("%d", &policy);
+            if(policy < 0 || policy >= POLICY_COUNT) printf("\nEnter a valid value!\n");
+        } while(policy < 0 || policy >= POLICY_COUNT);
+
+        int slice = 0;
+        if(policy == POLICY_ROUND_ROBIN) {
+            do {
+                printf("\nEnter time slice: ");
+                scanf("%d", &slice);
+                if(slice <= 0) printf("\nEnter a valid value!\n");
+            } while(slice <= 0);
+        }
+
+        GANTT *io_gantt = NULL;
+        GANTT *gantt = getGanttIO(process, n, (SCHED_POLICY)policy, slice, &io_gantt);
+
+        if(gantt) displayGantt(gantt);
+        printf("\nI/O device:-");
+        if(io_gantt) displayGantt(io_gantt);
+        displayProcessesIO(process, n, gantt, io_gantt);
+
+        destroyGantt(gantt);
+        destroyGantt(io_gantt);
+        destroyProcessesIO(process, n);
+    }
+}
@@ -0,0 +1,123 @@
+// Program to run an online scheduler over a long trace, with checkpoints to resume an interrupted run
+
+#include "Schedule.h"
+#include<unistd.h>
+
+int main(int argc, char *argv[]) {
+
+    /*
+        Usage: long_run <file> <algorithm number> <output file> <checkpoint file> [interval] [time slice] [stop time]
+        Processes are read as for priority scheduling and submitted as the simulation reaches their arrival.
+        Every GANTT entry is written to the output file as a tab separated line: pid, start, finish (pid -1 = IDLE).
+        A checkpoint is written every interval time units (default 1000), time slice defaults to 4.
+        If the checkpoint file exists the run resumes from it, the output file is cut back to the
+        point the checkpoint was taken, so it ends up identical to the one of an uninterrupted run.
+        With a stop time the program exits once the simulation passes it, as if it had been interrupted.
+    */
+
+    if(argc < 5) {
+        printf("\nUsage: %s <file> <algorithm number> <output file> <checkpoint file> [interval] [time slice] [stop time]\n",
+            argv[0]);
+        return 1;
+    }
+
+    int policy = atoi(argv[2]);
+    if(policy < 0 || policy >= POLICY_COUNT) {
+        printf("\nInvalid algorithm number!\n");
+        return 1;
+    }
+    SCHED_TIME interval = (argc > 5) ? atoll(argv[5]) : 1000;
+    SCHED_TIME time_slice = (argc > 6) ? atoll(argv[6]) : 4;
+    SCHED_TIME stop = (argc > 7) ? atoll(argv[7]) : -1;
+    if(interval <= 0) {
+        printf("\nInvalid checkpoint interval!\n");
+        return 1;
+    }
+
+    PROCESS *process = NULL;
+    int n = getProcessesFilePriority(argv[1], &process);
+    if(n < 1) return 1;
+
+    int *order = (int *)malloc(n*sizeof(int));     // submission order: arrival, then position in the file
+    EVENT_QUEUE arrivals;
+    eventInit(&arrivals, EVENTQ_AUTO, eventIndexLess, NULL);
+    for(int i = 0; i < n; i++) eventPush(&arrivals, i, process[i].arrive_time);
+    for(int k = 0; k < n; k++) order[k] = eventPop(&arrivals);
+    eventDestroy(&arrivals);
+
+    SCHEDULER *s = NULL;
+    FILE *out = NULL;
+    if(access(argv[4], F_OK) == 0) {
+        s = schedulerLoad(argv[4]);
+        if(s && (s->policy != (SCHED_POLICY)policy || s->n > n)) {
+            printf("\nCheckpoint does not belong to this run!\n");
+            destroyScheduler(s);
+            s = NULL;
+        }
+        if(s) {
+            out = fopen(argv[3], "r+");
+            if(!out || ftruncate(fileno(out), (off_t)s->output_offset) != 0 ||
+               fseek(out, (long)s->output_offset, SEEK_SET) != 0) {
+                printf("\nFailed to open the output file!\n");
+                if(out) fclose(out);
+                out = NULL;
+            }
+            else printf("\nResuming at time " TIME_FMT ", %d of %d processes completed\n", s->curr_time, s->completed, n);
+        }
+    }
+    else {
+        s = createScheduler((SCHED_POLICY)policy, time_slice);
+        out = fopen(argv[3], "w");
+        if(!out) printf("\nFailed to open the output file!\n");
+    }
+    if(!s || !out) {
+        destroyScheduler(s);
+        free(order);
+        destroyProcesses(process);
+        return 1;
+    }
+
+    schedulerSetCheckpoint(s, argv[4], interval);
+
+    int next = s->n;                                // processes submitted before the checkpoint
+    int stopped = 0;
+    SCHED_TIME last = 0;
+    while(s->completed < n) {
+        SCHED_TIME target = s->curr_time + interval;
+        while(next < n && process[order[next]].arrive_time <= target) schedulerSubmit(s, process[order[next++]]);
+        schedulerAdvanceTo(s, target);
+
+        GANTT *segments = schedulerPollSegments(s);
+        for(GANTT *g = segments; g; g = g->next) {
+            fprintf(out, "%d\t" TIME_FMT "\t" TIME_FMT "\n", g->pid, g->start_time, g->finish_time);
+            last = g->finish_time;
+        }
+        destroyGantt(segments);
+        fflush(out);                                // the next checkpoint may only count bytes that are in the file
+        fsync(fileno(out));
+        s->output_offset = ftell(out);
+
+        if(stop >= 0 && s->curr_time >= stop && s->completed < n) {
+            stopped = 1;
+            break;
+        }
+    }
+
+    if(stopped) printf("\nStopped at time " TIME_FMT ", rerun to resume from %s\n", s->curr_time, argv[4]);
+    else {
+        double wait = 0, tat = 0;
+        for(int i = 0; i < n; i++) {
+            wait += s->process[i].wait_time;
+            tat += s->process[i].turnaround_time;
+        }
+        printf("\n%s: %d processes, finished at " TIME_FMT, policyNames[policy], n, last);
+        printf("\nAverage Waiting Time: %.2f\nAverage Turnaround Time: %.2f\n", wait/n, tat/n);
+        remove(argv[4]);                            // the run is complete, the next one starts from scratch
+    }
+
+    fclose(out);
+    destroyScheduler(s);
+    free(order);
+    destroyProcesses(process);
+    return stopped ? 2 : 0;
+}
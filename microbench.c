@@ -0,0 +1,205 @@
+// Program to measure the selection primitives of the CPU scheduling algorithms in isolation
+
+#include "Schedule.h"
+#include<time.h>
+
+#define MIN_TIME_MS 100.0                           // every benchmark runs at least this long
+
+volatile long long sink;                            // results are written here so no loop is optimized away
+
+typedef struct bench
+{
+    /*
+        INTRODUCTION:
+            Structure to represent the state shared by the benchmarks of one backlog size.
+
+        VARIABLES:
+            - n (int):                  Backlog size (number of processes).
+            - w (WORKLOAD*):            Workload generated once, in arrival order (hot[i] is arrival i).
+            - shuffled (PROCESS_HOT*):  Hot fields in random order, input of the sort benchmark.
+            - ident (int*):             Identity order 0 ... n-1.
+            - queue (int*):             Round Robin queue of length n.
+    */
+
+    int n;
+    WORKLOAD *w;
+    PROCESS_HOT *shuffled;
+    int *ident, *queue;
+}BENCH;
+
+double elapsedMs(struct timespec start, struct timespec finish) {
+    // Milliseconds between two CLOCK_MONOTONIC readings
+    return (finish.tv_sec - start.tv_sec)*1e3 + (finish.tv_nsec - start.tv_nsec)/1e6;
+}
+
+void benchSort(BENCH *b, long long iters) {
+    // sortWorkload with the SJF key, on an unsorted copy every time (the copy is part of the cost)
+    for(long long it = 0; it < iters; it++) {
+        memcpy(b->w->hot, b->shuffled, b->n*sizeof(PROCESS_HOT));
+        for(int i = 0; i < b->n; i++) b->w->pid[i] = i;
+        sortWorkload(b->w, SORT_BURST);
+        sink += b->w->order[0];
+    }
+}
+
+void benchMinBurst(BENCH *b, long long iters) {
+    // SJF: shortest job of a ready window of n processes
+    for(long long it = 0; it < iters; it++)
+        sink += selectMinBurst(b->w->hot, b->ident, 0, b->n);
+}
+
+void benchResponseRatio(BENCH *b, long long iters) {
+    // HRRN: highest response ratio of a ready window of n processes
+    SCHED_TIME now = b->w->hot[b->n-1].arrive_time;
+    for(long long it = 0; it < iters; it++)
+        sink += selectMaxResponseRatio(b->w->hot, b->ident, 0, b->n, now + (it & 7));
+}
+
+void benchShortestRemaining(BENCH *b, long long iters) {
+    // SRTF: one scheduling decision with n arrived processes
+    for(long long it = 0; it < iters; it++)
+        sink += selectShortestRemaining(b->w->hot, b->n);
+}
+
+void benchAdmit(BENCH *b, long long iters) {
+    // Round Robin: admit all n processes into an empty queue (one call per arrival time)
+    PROCESS_HOT *hot = b->w->hot;
+    for(long long it = 0; it < iters; it++) {
+        int admitted = 0, rear = -1, q_size = 0;
+        for(int i = 0; i < b->n; i++) admitArrivals(hot, b->n, hot[i].arrive_time, &admitted, b->queue, &rear, &q_size);
+        sink += q_size;
+    }
+}
+
+void benchAppend(BENCH *b, long long iters) {
+    // Gantt chart: n appends, every other one merged into the previous entry, then the chart is freed
+    for(long long it = 0; it < iters; it++) {
+        GANTT *ghead = NULL, *gcurr = NULL;
+        for(int i = 0; i < b->n; i++) appendGantt(&ghead, &gcurr, (i/2) % 4, i, i+1);
+        sink += gcurr->finish_time;
+        destroyGantt(ghead);
+    }
+}
+
+void benchEvents(BENCH *b, long long iters, EVENTQ_KIND kind) {
+    // Arrivals of the backlog in random order, every arrival taken out queues its completion burst_time later
+    for(long long it = 0; it < iters; it++) {
+        EVENT_QUEUE q;
+        eventInit(&q, kind, eventIndexLess, NULL);
+        for(int i = 0; i < b->n; i++) eventPush(&q, i, b->shuffled[i].arrive_time);
+        while(q.size > 0) {
+            int idx = eventPop(&q);
+            if(idx < b->n) eventPush(&q, b->n + idx, q.now + b->shuffled[idx].burst_time);
+        }
+        sink += q.now;
+        eventDestroy(&q);
+    }
+}
+
+void benchEventHeap(BENCH *b, long long iters) {
+    benchEvents(b, iters, EVENTQ_HEAP);
+}
+
+void benchEventWheel(BENCH *b, long long iters) {
+    benchEvents(b, iters, EVENTQ_WHEEL);
+}
+
+typedef struct benchmark
+{
+    /*
+        INTRODUCTION:
+            Structure to represent one microbenchmark.
+
+        VARIABLES:
+            - name (char*):             Name of the primitive.
+            - run (function):           Runs the primitive iters times.
+            - per_process (int):        Non-zero if one iteration handles every process (ns/op is then per process).
+    */
+
+    const char *name;
+    void (*run)(BENCH *, long long);
+    int per_process;
+}BENCHMARK;
+
+BENCHMARK benchmarks[] = {
+    {"arrival_sort", benchSort, 0},
+    {"sjf_min_burst", benchMinBurst, 0},
+    {"hrrn_ratio", benchResponseRatio, 0},
+    {"srtf_scan", benchShortestRemaining, 0},
+    {"rr_admit", benchAdmit, 1},
+    {"gantt_append", benchAppend, 1},
+    {"event_heap", benchEventHeap, 1},
+    {"event_wheel", benchEventWheel, 1},
+};
+
+int main(int argc, char *argv[]) {
+
+    /*
+        Usage: microbench [backlog size ...]
+        Runs every primitive on a random backlog of every size (default 16 256 4096).
+        ns/op is per call of the primitive; for rr_admit and gantt_append it is per admitted
+        process / appended entry, for event_heap and event_wheel per process (two events each).
+    */
+
+    int sizes[16] = {16, 256, 4096}, n_sizes = 3;
+    if(argc > 1) {
+        n_sizes = 0;
+        for(int i = 1; i < argc && n_sizes < 16; i++)
+            if(atoi(argv[i]) > 0) sizes[n_sizes++] = atoi(argv[i]);
+    }
+
+    printf("\n%-28s%16s%16s", "Benchmark", "Iterations", "ns/op");
+    printf("\n------------------------------------------------------------");
+
+    for(int s = 0; s < n_sizes; s++) {
+        BENCH b;
+        b.n = sizes[s];
+
+        PROCESS *process = (PROCESS *)malloc(b.n*sizeof(PROCESS));
+        srand(42);
+        for(int i = 0; i < b.n; i++) {
+            process[i].pid = i;
+            process[i].arrive_time = rand() % (5*b.n + 1);
+            process[i].burst_time = process[i].initial_burst = 1 + rand() % 20;
+            process[i].priority = rand() % 10;
+        }
+        b.w = getWorkload(process, b.n);
+        b.shuffled = (PROCESS_HOT *)malloc(b.n*sizeof(PROCESS_HOT));
+        memcpy(b.shuffled, b.w->hot, b.n*sizeof(PROCESS_HOT));
+        sortWorkload(b.w, SORT_NONE);               // hot[i] is the i-th arrival
+        b.ident = (int *)malloc(b.n*sizeof(int));
+        b.queue = (int *)malloc(b.n*sizeof(int));
+        for(int i = 0; i < b.n; i++) b.ident[i] = i;
+
+        for(int k = 0; k < (int)(sizeof(benchmarks)/sizeof(benchmarks[0])); k++) {
+            BENCHMARK *m = &benchmarks[k];
+            long long iters = 1;
+            double ms = 0;
+
+            m->run(&b, 1);                          // warm-up
+            while(1) {
+                struct timespec start, finish;
+                clock_gettime(CLOCK_MONOTONIC, &start);
+                m->run(&b, iters);
+                clock_gettime(CLOCK_MONOTONIC, &finish);
+                ms = elapsedMs(start, finish);
+                if(ms >= MIN_TIME_MS || iters >= (1LL << 40)) break;
+                iters = (ms > 1.0) ? (long long)(iters * MIN_TIME_MS * 1.2 / ms) : iters * 10;
+            }
+            if(m->run == benchSort) sortWorkload(b.w, SORT_NONE);     // restore arrival order
+
+            long long ops = iters * (m->per_process ? b.n : 1);
+            char label[64];
+            snprintf(label, sizeof(label), "%s/%d", m->name, b.n);
+            printf("\n%-28s%16lld%16.1f", label, iters, ms*1e6/ops);
+        }
+
+        free(b.shuffled);
+        free(b.ident);
+        free(b.queue);
+        destroyWorkload(b.w);
+        free(process);
+    }
+    printf("\n------------------------------------------------------------\n");
+    return 0;
+}
@@ -28,8 +28,19 @@ void main() {
     if(n > 0) {
         GANTT *gantt = getGanttPriority(process, n);
 
+        /*
+            *** To age waiting processes (priority improves by 1 every 5 time units of waiting) ***
+            GANTT *gantt = getGanttPriorityAging(process, n, 5);
+        */
+
         if(gantt) displayGantt(gantt);
         displayProcesses(process, n);
+        displayStarvation(process, n);
+
+        /*
+            *** To export the schedule as a Chrome trace (open in ui.perfetto.dev) ***
+            exportChromeTrace("trace.json", gantt, process, n);
+        */
         
         destroyGantt(gantt);
         destroyProcesses(process);
@@ -28,8 +28,19 @@ void main() {
     if(n > 0) {
         GANTT *gantt = getGanttPriorityPreemptive(processes, n);
 
+        /*
+            *** To age waiting processes (priority improves by 1 every 5 time units of waiting) ***
+            GANTT *gantt = getGanttPriorityPreemptiveAging(processes, n, 5);
+        */
+
         if(gantt) displayGantt(gantt);
         displayProcesses(processes, n);
+        displayStarvation(processes, n);
+
+        /*
+            *** To export the schedule as a Chrome trace (open in ui.perfetto.dev) ***
+            exportChromeTrace("trace.json", gantt, processes, n);
+        */
         
         destroyGantt(gantt);
         destroyProcesses(processes);
@@ -37,8 +37,22 @@ void main() {
 
         GANTT *gantt = getGanttRoundRobin(process, n, slice);
 
+        /*
+            *** To charge context switch overhead (fixed, cache warm-up, time to go cold) ***
+            SWITCH_COST cost = {1, 2, 10};
+            GANTT *charged = applySwitchCost(gantt, process, n, cost);
+            destroyGantt(gantt);
+            gantt = charged;
+            displaySwitchStats(gantt);
+        */
+
         if(gantt) displayGantt(gantt);
         displayProcesses(process, n);
+
+        /*
+            *** To export the schedule as a Chrome trace (open in ui.perfetto.dev) ***
+            exportChromeTrace("trace.json", gantt, process, n);
+        */
         
         destroyGantt(gantt);
         destroyProcesses(process);